@@ -0,0 +1,50 @@
+###############################################################
+#
+# Bulk node transforms
+#
+# Animates a few thousand scene nodes by filling a float array
+# with positions and applying it to a NodeGroup in one call.
+# Set useNodeGroup to False to compare with per-node
+# setPosition calls. The script update time is printed
+# periodically.
+#
+###############################################################
+
+from omega import *
+from array import array
+from math import sin, cos
+
+numNodes = 5000
+useNodeGroup = True
+
+# Number of frames between stat reports
+reportInterval = 100
+
+group = NodeGroup.create()
+nodes = []
+for i in range(0, numNodes):
+	n = SceneNode.create("node" + str(i))
+	nodes.append(n)
+group.addNodes(nodes)
+
+# One (x, y, z) tuple per node. Any object supporting the buffer
+# protocol works here, including numpy float32 arrays.
+positions = array('f', [0.0] * (numNodes * 3))
+
+updateStat = Stat.find("Script update")
+
+def onUpdate(frame, t, dt):
+	for i in range(0, numNodes):
+		a = t + i * 0.01
+		positions[i * 3] = cos(a) * 2
+		positions[i * 3 + 1] = 2 + sin(a)
+		positions[i * 3 + 2] = -4
+	if(useNodeGroup):
+		group.setTransforms(positions)
+	else:
+		for i in range(0, numNodes):
+			nodes[i].setPosition(positions[i * 3], positions[i * 3 + 1], positions[i * 3 + 2])
+	if(frame % reportInterval == 0 and updateStat.getNumSamples() > 0):
+		print("frame " + str(frame) + " script update (ms) avg: " + str(updateStat.getAvg()))
+
+setUpdateFunction(onUpdate)
@@ -0,0 +1,39 @@
+###############################################################
+#
+# Procedural texture through the PixelData buffer protocol
+#
+# Fills a PixelData object one row at a time through a
+# memoryview, and displays it using an Image widget. With numpy
+# available, the whole image can be written at once, i.e.
+#   a = numpy.asarray(memoryview(pixels)).reshape(height, width, 4)
+#
+###############################################################
+
+from omega import *
+from omegaToolkit import *
+from math import sin
+
+width = 256
+height = 256
+
+ui = UiModule.createAndInitialize().getUi()
+
+pixels = PixelData.create(width, height, PixelFormat.FormatRgba)
+img = Image.create(ui)
+img.setData(pixels)
+img.setPosition(Vector2(5, 5))
+
+def onUpdate(frame, t, dt):
+	shift = int(sin(t) * 127 + 128)
+	# While the memoryview is alive the pixel data cannot be resized, and
+	# it gets uploaded to the gpu every frame. Releasing it marks the pixel
+	# data dirty one last time.
+	mv = memoryview(pixels)
+	pitch = pixels.getPitch()
+	for y in range(0, height):
+		g = chr((y + shift) % 256)
+		row = (chr(shift) + g + chr(255 - shift) + chr(255)) * width
+		mv[y * pitch : (y + 1) * pitch] = row
+	del mv
+
+setUpdateFunction(onUpdate)
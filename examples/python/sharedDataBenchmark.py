@@ -0,0 +1,46 @@
+###############################################################
+#
+# Shared data benchmark
+#
+# Run with the headless display system in local cluster mode, 
+# i.e. set localSlaves in system/headless.cfg, then:
+#   orun -c system/headless.cfg -s sharedDataBenchmark.py
+# Every frame the master broadcasts a python command carrying
+# payloadSize bytes. Periodically prints the serialized frame
+# size, master commit time, slowest slave apply time and 
+# end-to-end latency (master commit to end of slave update).
+# Run with different localSlaves values to compare.
+#
+###############################################################
+
+from omega import *
+
+# Size of the string sent to slaves every frame
+payloadSize = 16 * 1024
+
+# Number of frames between stat reports
+reportInterval = 200
+
+payload = 'x' * payloadSize
+received = 0
+
+def onPayload(p):
+	global received
+	received += len(p)
+
+statNames = ["Shared data bytes", "Shared data commit", "Shared data apply", "Shared data latency"]
+
+def report(frame):
+	line = "frame " + str(frame)
+	for name in statNames:
+		s = Stat.find(name)
+		if(s != None and s.getNumSamples() > 0):
+			line += " | " + name + " avg: " + str(s.getAvg()) + " max: " + str(s.getMax())
+	print(line)
+
+def onUpdate(frame, t, dt):
+	if(isMaster()):
+		broadcastCommand("onPayload('" + payload + "')")
+		if(frame % reportInterval == 0 and frame > 0): report(frame)
+
+setUpdateFunction(onUpdate)
@@ -0,0 +1,92 @@
+###############################################################
+#
+# UI pointer dispatch benchmark
+#
+# Builds grids of buttons of increasing size and reports the 
+# average time spent dispatching pointer events, with and
+# without the container hit test index. Keep moving the pointer
+# over the window while the benchmark runs.
+#
+###############################################################
+
+from omega import *
+from omegaToolkit import *
+
+# Widget counts to test (approximate, rounded to full rows)
+widgetCounts = [250, 1000, 4000]
+buttonsPerRow = 50
+
+# Number of frames each configuration runs for
+framesPerRun = 300
+
+uim = UiModule.createAndInitialize()
+ui = uim.getUi()
+
+root = None
+runs = []
+for count in widgetCounts:
+	runs.append((count, True))
+	runs.append((count, False))
+
+currentRun = -1
+runStartFrame = 0
+runStartTotal = 0
+runStartSamples = 0
+done = False
+
+dispatchStat = Stat.find("ui pointer dispatch")
+
+def buildGrid(count):
+	global root
+	if(root != None):
+		ui.removeChild(root)
+	root = Container.create(ContainerLayout.LayoutVertical, ui)
+	root.setPosition(Vector2(5, 5))
+	root.setPadding(0)
+	root.setMargin(0)
+	for i in range(0, count / buttonsPerRow):
+		row = Container.create(ContainerLayout.LayoutHorizontal, root)
+		row.setPadding(0)
+		row.setMargin(0)
+		for j in range(0, buttonsPerRow):
+			Button.create(row).setText(str(j))
+
+def getDispatchTotal():
+	if(dispatchStat.getNumSamples() == 0): return 0
+	return dispatchStat.getTotal()
+
+def startRun(index, frame):
+	global currentRun, runStartFrame, runStartTotal, runStartSamples
+	currentRun = index
+	runStartFrame = frame
+	(count, indexEnabled) = runs[index]
+	if(indexEnabled): buildGrid(count)
+	uim.setHitTestIndexEnabled(indexEnabled)
+	runStartTotal = getDispatchTotal()
+	runStartSamples = dispatchStat.getNumSamples()
+
+def endRun():
+	(count, indexEnabled) = runs[currentRun]
+	samples = dispatchStat.getNumSamples() - runStartSamples
+	if(samples > 0):
+		avg = (getDispatchTotal() - runStartTotal) / samples
+		print("widgets: " + str(count) + " index: " + str(indexEnabled) + 
+			" pointer events: " + str(samples) + " avg dispatch (ms): " + str(avg))
+	else:
+		print("widgets: " + str(count) + " index: " + str(indexEnabled) + 
+			" no pointer events received")
+
+def onUpdate(frame, t, dt):
+	global done
+	if(done): return
+	if(currentRun == -1):
+		startRun(0, frame)
+	elif(frame - runStartFrame >= framesPerRun):
+		endRun()
+		if(currentRun + 1 < len(runs)): 
+			startRun(currentRun + 1, frame)
+		else:
+			print("ui pointer dispatch benchmark done")
+			done = True
+
+setUpdateFunction(onUpdate)
@@ -0,0 +1,48 @@
+###############################################################
+#
+# UI layout benchmark
+#
+# Builds a few thousand nested widgets and changes the text of
+# a single label every frame. The time spent in ui layout is
+# read from the 'ui layout' stat and printed periodically.
+#
+###############################################################
+
+from omega import *
+from omegaToolkit import *
+
+# Number of rows and labels per row. 100 x 30 gives about 3000 labels
+# plus the row containers.
+numRows = 100
+labelsPerRow = 30
+
+# Number of frames between stat reports
+reportInterval = 100
+
+ui = UiModule.createAndInitialize().getUi()
+
+root = Container.create(ContainerLayout.LayoutVertical, ui)
+root.setPosition(Vector2(5, 5))
+
+labels = []
+for i in range(0, numRows):
+	row = Container.create(ContainerLayout.LayoutHorizontal, root)
+	for j in range(0, labelsPerRow):
+		l = Label.create(row)
+		l.setText(str(j))
+		labels.append(l)
+
+print("ui layout benchmark: " + str(len(labels)) + " labels in " + str(numRows) + " rows")
+
+layoutStat = Stat.find("ui layout")
+
+def onUpdate(frame, t, dt):
+	# Change the text of one label per frame, cycling through all of them.
+	l = labels[frame % len(labels)]
+	l.setText(str(frame))
+	if(frame % reportInterval == 0 and layoutStat.getNumSamples() > 0):
+		print("frame " + str(frame) + 
+			" ui layout (ms) avg: " + str(layoutStat.getAvg()) + 
+			" max: " + str(layoutStat.getMax()))
+
+setUpdateFunction(onUpdate)
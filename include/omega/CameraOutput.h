@@ -76,6 +76,13 @@ namespace omega {
 		RenderTarget* getRenderTarget() { return myRenderTarget; }
 		RenderTarget::Type getType() { return myType; }
 
+		//! When set to true, frames are read back asynchronously: the readback
+		//! target receives the pixels of each frame during the following frame,
+		//! without stalling the GPU pipeline. Disabled by default.
+		//! @see RenderTarget::setAsyncReadback
+		void setAsyncReadback(bool value);
+		bool isAsyncReadback() { return myAsyncReadback; }
+
 		//void lock() { myLock.lock();}
 		//void unlock() { myLock.unlock();}
 
@@ -91,8 +98,13 @@ namespace omega {
 		Texture* myTextureDepthTarget;
 
 		Rect myReadbackViewport;
+		bool myAsyncReadback;
 
 		Lock myLock;
+
+		// Stats
+		Ref<Stat> myReadbackTimeStat;
+		Ref<Stat> myReadbackLatencyStat;
 	};
 }; // namespace omega
 
@@ -46,6 +46,8 @@ namespace omega
 	public:
 		const float& operator[](int i) const { return myData[i]; }
 		float& operator[](int i) { return myData[i]; }
+		bool operator==(const Color& c) const { return memcmp(myData, c.myData, 4 * sizeof(float)) == 0; }
+		bool operator!=(const Color& c) const { return !(*this == c); }
 		float* data() { return (float*)myData; }
 		const float* data() const { return (const float*)myData; }
 
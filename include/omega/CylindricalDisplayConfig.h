@@ -46,6 +46,7 @@ namespace omega
     public:
         virtual bool buildConfig(DisplayConfig& cfg, Setting& scfg);
         virtual std::pair<bool, Vector2f> getPointFromRay(const Ray& r);
+        virtual void getPointsFromRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points);
 
     private:
         std::pair<bool, Vector2f> calculateScreenPosition(float x, float y, float z);
@@ -64,6 +64,14 @@ namespace omega
         //! Returns a 2D point at the intersection between the ray and the
         //! display surface. The 2D point is always in normalized coordinates.
         virtual std::pair<bool, Vector2f> getPointFromRay(const Ray& r) = 0;
+        //! Converts count rays to 2D points in a single pass. The default
+        //! implementation calls getPointFromRay for each ray. Converters 
+        //! should override this with a loop specialized for their display 
+        //! surface.
+        virtual void getPointsFromRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points)
+        {
+            for(int i = 0; i < count; i++) points[i] = getPointFromRay(rays[i]);
+        }
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -229,15 +237,34 @@ namespace omega
         //! be part of the tile grid.
         void setTilesEnabled(int tilex, int tiley, int tilew, int tileh, bool enabled);
 
+        //! Returns the tile containing the specified canvas pixel, or NULL
+        //! if no tile with mouse processing enabled contains it. Works for
+        //! arbitrary tile layouts and runs in constant time.
+        DisplayTileConfig* findTile(const Vector2i& position) const;
+        //! Batch version of findTile: looks up tiles for count positions 
+        //! and stores them in result.
+        void findTiles(const Vector2i* positions, int count, DisplayTileConfig** result) const;
+        //! Rebuilds the tile lookup used by findTile. Must be called after
+        //! changing tile offsets or pixel sizes. Called automatically when
+        //! the configuration is loaded and when a tile window is resized.
+        void updateTileLookup();
+
     public:
         // UGLY CONSTANTS.
         static const int MaxNodes = 64;
+        //! Maximum number of tile lookup cells on each axis.
+        static const int MaxLookupCells = 256;
         
         DisplayConfig(): 
             disableConfigGenerator(false), latency(1), 
+            sharedMemoryTransport(false), sharedMemorySlots(4), 
+            sharedMemorySlotSize(4096), sharedMemoryTimeout(10),
             enableSwapSync(true), forceMono(false), verbose(false),
             invertStereo(false),
-            rayToPointConverter(NULL)
+            rayToPointConverter(NULL),
+            myLookupOrigin(Vector2i::Zero()),
+            myLookupCellSize(Vector2i::Ones()),
+            myLookupSize(Vector2i::Zero())
         {
             memset(tileGrid, 0, sizeof(tileGrid));
         }		
@@ -321,8 +348,16 @@ namespace omega
         int numNodes;
         //! Node configurations for a multimachine display system.
         DisplayNodeConfig nodes[MaxNodes];
-        //! Interval in milliseconds between node launcher commands
+        //! Interval in milliseconds between node launcher commands. Only used
+        //! when launcherTimeout is 0.
         int launcherInterval; 
+        //! Maximum number of nodes being launched at the same time. A node
+        //! stops counting against this limit once it is ready. 0 = no limit.
+        int launcherParallelism;
+        //! Maximum time in seconds to wait for a launched node to start 
+        //! accepting connections. Set to 0 to disable readiness checks and
+        //! just wait launcherInterval after launching all nodes.
+        float launcherTimeout;
         //! Node launcher command.
         String nodeLauncher;
         //! Node killer command.
@@ -330,6 +365,27 @@ namespace omega
         //! Default port used to connect to nodes
         int basePort;
 
+        //! When set to true, nodes running on the same machine as the master
+        //! receive shared data through a shared memory ring instead of the
+        //! network.
+        bool sharedMemoryTransport;
+        //! Number of frames buffered in the shared memory ring.
+        int sharedMemorySlots;
+        //! Maximum size of a serialized shared data frame, in KB.
+        int sharedMemorySlotSize;
+        //! Seconds the master waits for a slow local node (and a local node
+        //! waits for the master) before the node is switched to the network
+        //! transport.
+        float sharedMemoryTimeout;
+
+        //! Interval in seconds between stat summaries sent by slave nodes
+        //! to the master. Set to 0 to disable cluster stats.
+        float statsAggregationInterval;
+        //! When set to true, frame timestamps are collected on all nodes and
+        //! sent to the master, which computes per-node latency stats.
+        //! See FrameTimeline.
+        bool latencyInstrumentation;
+
         //! The tile grid is needed for 2d interaction with tiles. and for 
         //! applications running on tile subsets.
         //! Configuration generators fill this up.
@@ -340,6 +396,22 @@ namespace omega
 
         Ref<DisplayConfigBuilder> configBuilder;
         IRayToPointConverter* rayToPointConverter;
+
+    private:
+        //! Finds a tile in the lookup. Callers must hold myLookupLock.
+        DisplayTileConfig* lookupTile(const Vector2i& position) const;
+
+        //! Tile lookup: the area covered by tiles is split in a grid of cells
+        //! no smaller than the smallest tile, so each cell overlaps at most a
+        //! few tiles. Tiles overlapping cell i are stored in myLookupTiles
+        //! between myLookupCellStart[i] and myLookupCellStart[i + 1].
+        Vector2i myLookupOrigin;
+        Vector2i myLookupCellSize;
+        Vector2i myLookupSize;
+        Vector<int> myLookupCellStart;
+        Vector<DisplayTileConfig*> myLookupTiles;
+        //! Window resize events rebuild the lookup from the window threads.
+        mutable Lock myLookupLock;
     };
 }; // namespace omega
 
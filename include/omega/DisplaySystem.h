@@ -52,7 +52,7 @@ class SystemManager;
 class OMEGA_API DisplaySystem: public ReferenceType
 {
 public:
-    enum DisplaySystemType { Invalid, Equalizer, Glut };
+    enum DisplaySystemType { Invalid, Equalizer, Glut, Headless };
 
 public:
     virtual ~DisplaySystem() {}
@@ -49,6 +49,11 @@ namespace omega
         static Ray getViewRay(Vector2i position, const DisplayConfig& cfg);
         //! Returns a view ray given a local pointer positon and a tile index.
         static Ray	getViewRay(Vector2i position, DisplayTileConfig* dtc);
+        //! Batch version of getViewRay: computes view rays for count global
+        //! pointer positions. Tile geometry and camera transforms are 
+        //! computed once per tile instead of once per position. Positions 
+        //! outside mouse-enabled tiles get an empty ray.
+        static void getViewRays(const Vector2i* positions, int count, Ray* rays, const DisplayConfig& cfg);
         //! Computes a view ray from a pointer or wand event. Returns true if the ray has been generated succesfully, 
         //! false otherwise (i.e. because the event is not a wand or pointer event)
         static bool getViewRayFromEvent(const Event& evt, Ray& ray, const DisplayConfig& cfg, bool normalizedPointerCoords = false, Camera* = NULL);
@@ -62,6 +67,10 @@ namespace omega
         //! @note only display configs providing a ray-to-point converter object
         //! can be used with this method.
         static std::pair<bool, Vector2f> getDisplayPointFromViewRay(const Ray& ray, const DisplayConfig& cfg, bool normalizedPointerCoords = false);
+        //! Batch version of getDisplayPointFromViewRay: converts count rays
+        //! in a single pass through the display ray-to-point converter.
+        //! @returns the number of rays intersecting the display.
+        static int getDisplayPointsFromViewRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points, const DisplayConfig& cfg, bool normalizedPointerCoords = false);
 
     private:
         DisplayUtils();
@@ -227,6 +227,11 @@ namespace omega {
         Ref<Stat> myUpdateTimeStat;
         Ref<Stat> mySceneUpdateTimeStat;
         Ref<Stat> myModuleUpdateTimeStat;
+        // Time from engine initialization to the end of the first update
+        // (which runs the startup script).
+        Ref<Stat> myStartupTimeStat;
+        Timer myStartupTimer;
+        bool myFirstUpdateDone;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -40,6 +40,8 @@
 
 #include "DisplaySystem.h"
 #include "ApplicationBase.h"
+#include "SharedMemoryRing.h"
+#include "StatsManager.h"
 
 namespace omega
 {
@@ -100,7 +102,25 @@ namespace omega
 
         void exitConfig();
 
+        //! @internal Returns the shared memory ring used to send shared data
+        //! to nodes running on the master machine, or NULL if the shared 
+        //! memory transport is disabled. Valid on the master only.
+        SharedMemoryRing* getSharedMemoryRing() { return myRing; }
+        //! @internal Slave nodes: opens the shared memory ring created by the
+        //! master. Returns NULL if the transport is disabled, if this node 
+        //! does not run on the master machine, or if the ring found does not
+        //! carry the specified session token (i.e. it is a stale ring left 
+        //! by a crashed instance).
+        SharedMemoryRing* openSharedMemoryRing(uint64 sessionToken);
+
     private:
+        String getSharedMemoryRingName();
+        //! Runs the node launcher for all enabled cluster nodes, and waits
+        //! for them to become ready.
+        void launchNodes();
+        String getNodeLaunchCommand(DisplayNodeConfig& nc);
+        bool isMasterHost(const String& hostname);
+
         void generateEqConfig();
         void setupEqInitArgs(int& numArgs, const char** argv);
         String buildTileConfig(String& indent, const String tileName, int x, int y, int width, int height, int device, int curdevice, bool fullscreen, bool borderless);
@@ -115,6 +135,14 @@ namespace omega
         EqualizerNodeFactory* myNodeFactory;
         ConfigImpl* myConfig;
 
+        // Shared memory transport for nodes running on the master machine.
+        Ref<SharedMemoryRing> myRing;
+
+        // Node launch stats. Kept here so they stay registered with the 
+        // stats manager after startup.
+        Ref<Stat> myLaunchStat;
+        List< Ref<Stat> > myNodeReadyStats;
+
         // Debug
         bool myDebugMouse;
     };
@@ -29,6 +29,7 @@
 
 #include "omega/osystem.h"
 #include "omega/ModuleServices.h"
+#include "omega/EventUtils.h"
 
 namespace omega
 {
@@ -42,12 +43,28 @@ namespace omega
 		//! Flag for local events.
 		static const uint LocalEventFlag = Event::User << 2;
 
+		//! The event count at the start of each batch carries the batch 
+		//! encoding in its upper bits. Batches written by older versions have
+		//! no encoding bits and use the full encoding.
+		static const int EncodingShift = 16;
+
 	public:
 		static void markLocal(const Event& evt);
 		static bool isLocal(const Event& evt);
 		static void share(const Event& evt);
         static void clearQueue();
 
+		//! When enabled (the default), events are sent to slave nodes using
+		//! the compact encoding. See EventUtils.
+		//! Set through config/compactEventEncoding in the system config.
+		static void setCompactEncodingEnabled(bool value);
+		static bool isCompactEncodingEnabled();
+		//! When enabled, the compact encoding also quantizes orientations.
+		//! This is lossy. Disabled by default. Set through 
+		//! config/quantizeEventOrientation in the system config.
+		static void setOrientationQuantizationEnabled(bool value);
+		static bool isOrientationQuantizationEnabled();
+
 		EventSharingModule();
 
 		virtual void commitSharedData(SharedOStream& out);
@@ -60,8 +77,28 @@ namespace omega
 		Lock myQueueLock;
 		Event myEventQueue[MaxSharedEventsQueue];
 		int myQueuedEvents;
+
+		EventUtils::CompactContext myEncodeContext;
+		EventUtils::CompactContext myDecodeContext;
+		bool myCompactEncoding;
 	};
 
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	inline void EventSharingModule::setCompactEncodingEnabled(bool value)
+	{ if(mysInstance != NULL) mysInstance->myCompactEncoding = value; }
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool EventSharingModule::isCompactEncodingEnabled()
+	{ return mysInstance != NULL && mysInstance->myCompactEncoding; }
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	inline void EventSharingModule::setOrientationQuantizationEnabled(bool value)
+	{ if(mysInstance != NULL) mysInstance->myEncodeContext.quantizeOrientation = value; }
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	inline bool EventSharingModule::isOrientationQuantizationEnabled()
+	{ return mysInstance != NULL && mysInstance->myEncodeContext.quantizeOrientation; }
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void EventSharingModule::markLocal(const Event& evt)
 	{
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	Conversion of omegalib events to and from the stream format used to share
+ *  data between nodes.
+ ******************************************************************************/
+#ifndef __EVENT_UTILS_H__
+#define __EVENT_UTILS_H__
+
+#include "omega/osystem.h"
+#include "omega/SharedDataServices.h"
+
+namespace omicron {
+	///////////////////////////////////////////////////////////////////////////
+	//! This class provides utility methods for converting omegalib events into
+	//! the stream format used to share data between nodes.
+	//! The full encoding writes every event field at full width. The compact
+	//! encoding writes a field presence mask followed by variable length 
+	//! integers, and omits fields that did not change from the previous event
+	//! in the same batch (or from the previous event of the same source, for
+	//! position and orientation). Orientations can optionally be quantized to
+	//! 7 bytes. Compact encoding is stateful: a batch of events must be 
+	//! decoded in the same order it was encoded, using a context reset at the
+	//! start of the batch on both sides.
+    class OMEGA_API EventUtils
+    {
+    public:
+        enum Encoding { EncodingFull = 0, EncodingCompact = 1 };
+
+        ///////////////////////////////////////////////////////////////////////
+        //! State shared by the events of a batch using the compact encoding.
+        struct OMEGA_API CompactContext
+        {
+            CompactContext(): quantizeOrientation(false) { reset(); }
+            //! Call at the start of each batch.
+            void reset();
+            //! Returns the state of the specified source, adding it if needed.
+            //! New sources start with zero position and identity orientation.
+            struct SourceState;
+            SourceState& getSource(int64_t serviceId, int64_t sourceId);
+
+            //! When set to true, the encoder quantizes orientations. This is
+            //! lossy (error < 1e-4 per component): nodes receiving the event 
+            //! will see a slightly different orientation than the master.
+            bool quantizeOrientation;
+
+            // Last event fields.
+            int64_t timestamp;
+            int64_t sourceId;
+            int64_t serviceId;
+            int64_t serviceType;
+            int64_t type;
+            int64_t flags;
+
+            // Last position and orientation of each source in the batch.
+            struct SourceState
+            {
+                int64_t serviceId;
+                int64_t sourceId;
+                float position[3];
+                float orientation[4];
+            };
+            std::vector<SourceState> sources;
+        };
+
+    public:
+        static void serializeEvent(Event& evt, omega::SharedOStream& os);
+        static void deserializeEvent(Event& evt, omega::SharedIStream& is);
+        static void serializeEventCompact(Event& evt, CompactContext& ctx, omega::SharedOStream& os);
+        static void deserializeEventCompact(Event& evt, CompactContext& ctx, omega::SharedIStream& is);
+
+    private:
+        EventUtils() {}
+    };
+};
+
+#endif
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	Timestamps collected along the cluster frame pipeline, used to measure 
+ *  end-to-end frame latency on each node.
+ ******************************************************************************/
+#ifndef __FRAME_TIMELINE_H__
+#define __FRAME_TIMELINE_H__
+
+#include "omega/osystem.h"
+#include "omega/StatsManager.h"
+
+namespace omega
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //! Timestamps of a frame, in seconds. Poll and commit are taken on the 
+    //! master. The other stages are taken on the node rendering the frame.
+    struct FrameTiming
+    {
+        uint64 frame;
+        //! Input events polled from the service manager.
+        double pollTime;
+        //! Shared data committed and master update done: the frame is about
+        //! to be started on the nodes.
+        double commitTime;
+        //! Shared data applied on the node.
+        double applyTime;
+        //! First channel on the node starts drawing.
+        double drawStart;
+        //! Last channel on the node finished drawing.
+        double drawEnd;
+        //! Last window on the node swapped buffers.
+        double swapTime;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //! Collects frame timestamps and turns them into per-node latency stats.
+    //! Each node records the stages of the frames it renders, and reports 
+    //! completed frames to the master. The master estimates the clock offset 
+    //! of each node (using the commit / apply and send / receive time pairs
+    //! of each report, like NTP does) and converts node timestamps to its own
+    //! clock before computing the latency breakdown.
+    class OMEGA_API FrameTimeline: public ReferenceType
+    {
+    public:
+        //! Number of frames kept for the timeline dump.
+        static const int MaxHistory = 1024;
+
+        static FrameTimeline* instance();
+        //! Returns a monotonic timestamp in seconds.
+        static double getTime();
+
+        FrameTimeline();
+
+        //! Node side
+        //@{
+        //! Starts tracking a frame. Call after shared data has been applied.
+        void beginFrame(uint64 frame);
+        //! These can be called from any render thread.
+        void markDrawStart(uint64 frame);
+        void markDrawEnd(uint64 frame);
+        void markSwap(uint64 frame);
+        //! Removes a tracked frame older than the specified one, and returns 
+        //! its timestamps. Returns false if there are no such frames.
+        bool popFrame(uint64 before, FrameTiming& timing);
+        //@}
+
+        //! Master side
+        //@{
+        void addMasterFrame(uint64 frame, double pollTime, double commitTime);
+        //! Adds a frame reported by a node. sendTime (node clock) and 
+        //! receiveTime (master clock) are used to update the node clock offset.
+        void addNodeFrame(const String& node, const FrameTiming& timing, double sendTime, double receiveTime);
+        //! Adds a frame rendered by the master itself (no clock offset).
+        void addLocalFrame(const String& node, const FrameTiming& timing);
+        //! Returns the estimated offset of the node clock from the master 
+        //! clock, in seconds.
+        double getClockOffset(const String& node);
+        //! Writes the recent frame history to a csv file. Times are in 
+        //! milliseconds, on the master clock.
+        bool dumpTimeline(const String& filename);
+        //@}
+
+    private:
+        struct NodeInfo
+        {
+            double clockOffset;
+            double bestRoundTrip;
+            Ref<Stat> transferStat;
+            Ref<Stat> drawWaitStat;
+            Ref<Stat> drawStat;
+            Ref<Stat> swapStat;
+            Ref<Stat> totalStat;
+        };
+        struct Record
+        {
+            String node;
+            FrameTiming timing;
+        };
+
+        NodeInfo& getNode(const String& node);
+        void addFrame(const String& node, NodeInfo& info, FrameTiming timing);
+        FrameTiming* findPending(uint64 frame);
+
+    private:
+        static Ref<FrameTimeline> mysInstance;
+        static const int MaxPendingFrames = 16;
+        static const int MaxMasterFrames = 64;
+
+        Lock myLock;
+
+        // Node side: frames being rendered.
+        FrameTiming myPending[MaxPendingFrames];
+        bool myPendingValid[MaxPendingFrames];
+
+        // Master side.
+        FrameTiming myMasterFrames[MaxMasterFrames];
+        Dictionary<String, NodeInfo> myNodes;
+        List<Record> myHistory;
+        Ref<Stat> myCommitStat;
+    };
+}; // namespace omega
+
+#endif
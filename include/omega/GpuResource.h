@@ -40,11 +40,14 @@
 #define GL_TEXTURE7 0x84C7
 #define GL_TEXTURE8 0x84C8
 
-namespace omega
-{
+namespace omega
+{
+	class GpuResource;
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	class OMEGA_API GpuContext: public ReferenceType
 	{
+	friend class GpuResource;
 	public:
 		static const unsigned int MaxContexts = 64;
 		enum TextureUnit {
@@ -54,29 +57,126 @@ namespace omega
 			TextureUnit2 = GL_TEXTURE2,
 			TextureUnit3 = GL_TEXTURE3 };
 
+		enum ObjectType { ObjectTexture, ObjectBuffer, ObjectFramebuffer, ObjectRenderbuffer };
+
 		GpuContext();
 
 		uint getId() { return myId; }
 		//GpuManager* getGpu() { return myGpu; }
 
+		//! Number of the frame currently being drawn in this context. Used
+		//! to track resource usage.
+		uint64 getFrameNum() { return myFrameNum; }
+		void setFrameNum(uint64 value) { myFrameNum = value; }
+
+		//! Resource management
+		//@{
+		//! Queues an OpenGL object for deletion. This method can be called 
+		//! from any thread, typically by a resource destructor. Queued objects
+		//! are deleted during the next call to releaseObjects.
+		void queueRelease(ObjectType type, GLuint id, size_t size = 0);
+		//! Deletes all the OpenGL objects queued for release. Must be called
+		//! from the thread owning this context. The cost of this call only
+		//! depends on the number of queued objects.
+		void releaseObjects();
+		//! Disposes all the live resources in this context. Used at shutdown.
+		void disposeResources();
+		//! Evicts least recently used evictable resources until the memory
+		//! usage is below the specified budget. Resources used in the current
+		//! frame are never evicted. Returns the number of evicted resources.
+		int evictResources(size_t budget);
+		//! Returns the estimated GPU memory used by the resources in this
+		//! context, in bytes.
+		size_t getGpuMemoryUsage() { return myGpuMemoryUsage; }
+		//@}
+
+	private:
+		void addResource(GpuResource* res);
+		void removeResource(GpuResource* res);
+
 	private:
 		static uint mysNumContexts;
 		static Lock mysContextLock;
 
 		uint myId;
+		uint64 myFrameNum;
 		//GpuManager* myGpu;
+
+		struct ReleaseRequest
+		{
+			ObjectType type;
+			GLuint id;
+			size_t size;
+		};
+
+		// Live resources are kept in an intrusive list, so that adding and
+		// removing resources is a constant time operation.
+		Lock myResourceLock;
+		GpuResource* myFirstResource;
+		Vector<ReleaseRequest> myReleaseQueue;
+		// Only modified by the thread owning the context.
+		size_t myGpuMemoryUsage;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
+	//! Base class for objects owning OpenGL resources. GpuResources register
+	//! themselves with their context on creation. Since the last reference to 
+	//! a resource can be released on any thread, resource destructors do not
+	//! delete OpenGL objects directly: they queue them for release on their 
+	//! context instead (see GpuContext::queueRelease). Resources hold a reference
+	//! to their context, so the context outlives every resource created on it.
 	class OMEGA_API GpuResource: public ReferenceType
 	{
+	friend class GpuContext;
 	public:
-		GpuResource(GpuContext* ctx): myContext(ctx) { dispose(); }
+		GpuResource(GpuContext* ctx);
+		virtual ~GpuResource();
 		GpuContext* getContext() { return myContext; }
 		virtual void dispose() {}
+
+		//! Memory accounting and eviction
+		//@{
+		//! Returns an estimate of the GPU memory used by this resource, in bytes.
+		size_t getGpuMemorySize() { return myGpuMemorySize; }
+		//! Marks this resource as used during the current frame.
+		void touch();
+		uint64 getLastUseFrame() { return myLastUseFrame; }
+		//! Returns true if this resource can be released when the renderer
+		//! goes over its memory budget, and re-created later on demand.
+		virtual bool isEvictable() { return false; }
+		//! Releases the GPU storage of an evictable resource.
+		virtual void evict() { dispose(); }
+		//@}
+
+	protected:
+		//! Must be called from the thread owning the context.
+		void setGpuMemorySize(size_t value);
+		//! Removes this resource from its context resource list. Derived class
+		//! destructors must call this before queueing their objects for release,
+		//! so the context will not try to dispose or evict them.
+		void unregister();
+
 	private:
-		GpuContext* myContext;
-	};
-}; // namespace omega
-
-#endif
+		Ref<GpuContext> myContext;
+		size_t myGpuMemorySize;
+		uint64 myLastUseFrame;
+
+		// Intrusive list links, managed by GpuContext.
+		bool myRegistered;
+		GpuResource* myPrevResource;
+		GpuResource* myNextResource;
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	inline void GpuResource::touch()
+	{ if(myContext != NULL) myLastUseFrame = myContext->getFrameNum(); }
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	inline void GpuResource::setGpuMemorySize(size_t value)
+	{
+		if(myContext != NULL) myContext->myGpuMemoryUsage += value - myGpuMemorySize;
+		myGpuMemorySize = value;
+	}
+}; // namespace omega
+
+#endif
\ No newline at end of file
@@ -0,0 +1,139 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	A display system that runs the omegalib engine loop without opening any
+ *  window or graphics context. Used for benchmarks and automated tests on
+ *  machines without a display.
+ ******************************************************************************/
+#ifndef __HEADLESS_DISPLAY_SYSTEM_H__
+#define __HEADLESS_DISPLAY_SYSTEM_H__
+
+#include "DisplaySystem.h"
+#include "StatsManager.h"
+#include "SharedDataServices.h"
+#include "SharedMemoryRing.h"
+
+namespace omega
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Forward Declarations.
+    class Engine;
+
+    ///////////////////////////////////////////////////////////////////////////
+    //! Implements a display system with no windows and no rendering.
+    //! The headless display system polls services, dispatches events and
+    //! updates the engine (including script and scene updates) in a loop. 
+    //! Rendering is stubbed out: no renderers are created, so render passes
+    //! are never initialized or drawn.
+    //! The loop can run on a free-running clock (dt = measured frame time) or
+    //! on a fixed clock (dt = frameTime, time advances deterministically).
+    //! Configuration options (in the display section):
+    //!  - frameTime: fixed frame time in seconds. 0 = free running (default).
+    //!  - maxFps: if > 0, throttles the loop to the specified frame rate.
+    //!  - maxFrames: if > 0, the application exits after this many frames.
+    //!  - canvasSize: canvas size in pixels, returned by getCanvasSize. 
+    //!    Defaults to the canvas size computed from the display geometry.
+    //!
+    //! Local cluster mode: when localSlaves is greater than zero, the master
+    //! instance launches that many slave instances on the same machine (using
+    //! nodeLauncher, like cluster display systems do). Every frame, the master
+    //! serializes the shared objects (see SharedDataServices) into a 
+    //! SharedMemoryRing, and slaves apply the data before updating, exactly
+    //! like Equalizer slave nodes do. Additional options:
+    //!  - sharedMemorySlots: number of frames buffered in the ring (default 4)
+    //!  - sharedMemorySlotSize: max serialized frame size in KB (default 4096).
+    //!    The cluster exits if a frame does not fit.
+    //!  - transportTimeout: seconds before a non responding instance is 
+    //!    considered dead (default 10)
+    //! The master collects shared data stats: "Shared data bytes", 
+    //! "Shared data commit", and the slowest slave "Shared data apply" time and
+    //! "Shared data latency" (time from master commit to the end of the slave
+    //! update, in milliseconds).
+    class OMEGA_API HeadlessDisplaySystem: public DisplaySystem
+    {
+    public:
+        HeadlessDisplaySystem();
+        virtual ~HeadlessDisplaySystem();
+
+        // sets up the display system. Called before initalize.
+        virtual void setup(Setting& setting);
+
+        virtual void initialize(SystemManager* sys); 
+        virtual void run(); 
+        virtual void cleanup(); 
+
+        virtual DisplaySystemType getId() { return DisplaySystem::Headless; }
+
+        //! Returns the size of the display canvas.
+        virtual Vector2i getCanvasSize() { return myCanvasSize; }
+
+        Engine* getEngine() { return myEngine; }
+        //! Returns the number of frames run so far.
+        uint64 getFrameCount() { return myFrameCount; }
+        //! Returns true if this instance is part of a local cluster.
+        bool isLocalCluster() { return myLocalSlaves > 0 || mySlaveIndex >= 0; }
+
+    private:
+        void runFrame(const UpdateContext& context);
+        void launchSlaves();
+        void commitSharedData();
+        bool updateSharedData();
+
+    private:
+        SystemManager* mySys;
+        Ref<Engine> myEngine;
+
+        Vector2i myCanvasSize;
+        float myFrameTime;
+        float myMaxFps;
+        uint64 myMaxFrames;
+        uint64 myFrameCount;
+
+        Ref<Stat> myFpsStat;
+        Ref<Stat> myFrameTimeStat;
+
+        // Local cluster mode
+        int myLocalSlaves;
+        int mySlaveIndex;
+        double myTransportTimeout;
+        Ref<SharedMemoryRing> myRing;
+        SharedObjectRegistry mySharedData;
+        Vector<char> mySharedDataBuffer;
+
+        Ref<Stat> mySharedDataBytesStat;
+        Ref<Stat> mySharedDataCommitStat;
+        Ref<Stat> mySharedDataApplyStat;
+        Ref<Stat> mySharedDataLatencyStat;
+    };
+}; // namespace omega
+
+#endif
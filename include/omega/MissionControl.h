@@ -221,6 +221,7 @@ namespace omega {
 		asio::io_service myIoService;
 		Ref<MissionControlConnection> myConnection;
 		List<Stat*> myEnabledStats;
+		List<String> myEnabledClusterStats;
 	};
 
 	///////////////////////////////////////////////////////////////////////////
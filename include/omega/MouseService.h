@@ -28,6 +28,7 @@
 #define __MOUSE__SERVICE_H__
 
 #include "omega/osystem.h"
+#include "omega/StatsManager.h"
 
 namespace omega
 {
@@ -48,15 +49,47 @@ public:
 
 	virtual void setup(Setting& settings);
 	virtual void initialize();
+	virtual void poll();
 	virtual void dispose();
 
 	void setPointerRay(const Ray& ray);
 
+	//! Motion event coalescing
+	//@{
+	//! When enabled, the motion callbacks received during a frame generate a 
+	//! single Move event with the final pointer position. Button and wheel 
+	//! events are never merged: they flush the pending motion first, to keep
+	//! event ordering.
+	void setMotionCoalescingEnabled(bool value) { myMotionCoalescingEnabled = value; }
+	bool isMotionCoalescingEnabled() { return myMotionCoalescingEnabled; }
+	//! When enabled, Move events carry a third extra data vector containing
+	//! the pointer path length since the previous Move event and the number of
+	//! motion callbacks merged into the event.
+	void setMotionPathLengthEnabled(bool value) { myMotionPathLengthEnabled = value; }
+	bool isMotionPathLengthEnabled() { return myMotionPathLengthEnabled; }
+	//@}
+
+private:
+	//! Writes the pending motion event, if any. Must be called with events locked.
+	void flushMotion();
+
 private:
 	static MouseService* mysInstance;
 	static int screenX, screenY, serverX, serverY, screenOffsetX, screenOffsetY;
 
 	Ray myPointerRay;
+
+	bool myMotionCoalescingEnabled;
+	bool myMotionPathLengthEnabled;
+	// Pending (not yet written) motion event data
+	bool myMotionPending;
+	bool myMotionPositionValid;
+	Vector2i myMotionPosition;
+	float myMotionPathLength;
+	int myMotionMergedCount;
+	// Number of motion callbacks merged since the last poll
+	int myCoalescedCount;
+	Ref<Stat> myCoalescedEventsStat;
 };
 
 }; // namespace omega
@@ -54,6 +54,7 @@ namespace omega {
     */
     class OMEGA_API Node: public ReferenceType 
     {
+    friend class NodeGroup;
     public:
         /** Enumeration denoting the spaces which a transform can be relative to.
         */
@@ -583,6 +584,36 @@ namespace omega {
 		//typedef std::vector<Node*> QueuedUpdates;
 		//static QueuedUpdates msQueuedUpdates;
     };
+
+	///////////////////////////////////////////////////////////////////////////
+	//! A list of nodes whose transforms can be set or read in bulk.
+	//! @remarks Transform arrays contain one tightly packed tuple per node,
+	//! in group order: 3 floats for positions and scales, 4 floats (w, x, y, z)
+	//! for orientations.
+	class OMEGA_API NodeGroup: public ReferenceType
+	{
+	public:
+		//! #PYAPI Creates an empty node group.
+		static NodeGroup* create() { return new NodeGroup(); }
+
+		//! Adds a node to the group. NULL nodes are ignored.
+		void addNode(Node* node);
+		void removeNode(Node* node);
+		void clear() { myNodes.clear(); }
+		int size() { return (int)myNodes.size(); }
+		Node* getNode(int index) { return myNodes[index]; }
+
+		//! Sets the local transforms of all the nodes in the group. Any of
+		//! the arrays can be NULL, to leave that transform component unchanged.
+		//! Each node is marked for update once.
+		void setTransforms(const float* positions, const float* orientations, const float* scales);
+		//! Reads the derived (world) transforms of all the nodes in the group.
+		//! Any of the arrays can be NULL, to skip that transform component.
+		void getDerivedTransforms(float* positions, float* orientations, float* scales);
+
+	private:
+		Vector< Ref<Node> > myNodes;
+	};
 }; //namespace
 
 #endif
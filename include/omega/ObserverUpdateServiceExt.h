@@ -29,6 +29,7 @@
 
 #include "omega/osystem.h"
 #include "omega/Camera.h"
+#include "omega/StatsManager.h"
 
 namespace omega
 {
@@ -52,6 +53,9 @@ namespace omega
 
 	private:
 		void updateDynamicSource(Event* evt);
+		//! Runs a new head position sample through the prediction filter, and
+		//! returns the head position extrapolated to the expected display time.
+		Vector3f predictHeadPosition(const Vector3f& pos, uint timestamp);
 
 	private:
 		Camera* myObserver;
@@ -76,6 +80,34 @@ namespace omega
 		float myCurrentMovementThreshold;
 		float myMovementThresholdTarget;
 		float myMovementThresholdCoeff;
+
+		// Head position prediction (alpha-beta filter)
+		bool myPredictionEnabled;
+		bool myPredictionInitialized;
+		// Tracker and display pipeline latency in seconds. Added to the 
+		// measured frame time to get the prediction interval.
+		float myPredictionLatency;
+		float myPredictionAlpha;
+		float myPredictionBeta;
+		// Maximum head speed in meters per second, used to clamp the 
+		// estimated velocity on tracking glitches.
+		float myPredictionMaxSpeed;
+		Vector3f myFilteredPosition;
+		Vector3f myFilteredVelocity;
+		uint myLastSampleTimestamp;
+		// Time of the last sample in seconds, accumulated from sample 
+		// intervals. Used to check extrapolated positions against samples.
+		float mySampleTime;
+		Vector3f myLastSamplePosition;
+		// Extrapolated position waiting to be checked against the samples 
+		// received at its target time.
+		bool myPredictionPending;
+		Vector3f myPendingPrediction;
+		float myPendingPredictionTime;
+		// Smoothed frame time in seconds, measured between polls.
+		float myFrameTime;
+		Timer myFrameTimer;
+		Ref<Stat> myPredictionErrorStat;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
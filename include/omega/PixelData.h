@@ -92,6 +92,22 @@ namespace omega {
 		void endPixelAccess();
 		//@}
 
+		//! Shared mapping, used to expose pixel memory to external code like
+		//! the python buffer protocol. Mappings do not hold the pixel data 
+		//! lock: they only prevent resize from reallocating the pixel memory.
+		//! Mapped pixel data is considered dirty every frame, since external
+		//! code can write to it at any time, and is marked dirty once more
+		//! on each release. Returns NULL for pixel buffer objects, since 
+		//! those can only be mapped from a gpu context.
+		//@{
+		byte* retainMapping();
+		void releaseMapping();
+		bool isMapped() { return myMappingCount > 0; }
+		//@}
+
+		virtual Texture* getTexture(const DrawContext& context);
+		virtual bool isDirty() { return myMappingCount > 0 || TextureSource::isDirty(); }
+
 	protected:
 		void refreshTexture(Texture* texture, const DrawContext& context);
 
@@ -101,6 +117,9 @@ namespace omega {
 	private:
 		uint myUsageFlags;
 		bool myChangingPixels;
+		int myMappingCount;
+		//! Frame of the last texture refresh caused by active mappings.
+		uint64 myMappedRefreshFrame;
 
 		Lock myLock;
 		Format myFormat;
@@ -32,10 +32,19 @@
 namespace omega
 {
 	///////////////////////////////////////////////////////////////////////////////////////////////
-	class PlanarDisplayConfig: public DisplayConfigBuilder
+	class PlanarDisplayConfig: public DisplayConfigBuilder, public IRayToPointConverter
 	{
 	public:
 		virtual bool buildConfig(DisplayConfig& cfg, Setting& scfg);
+		virtual std::pair<bool, Vector2f> getPointFromRay(const Ray& r);
+		virtual void getPointsFromRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points);
+
+	private:
+		// Top left corner of the display wall. The wall lies on a plane
+		// orthogonal to the z axis.
+		Vector3f myCanvasTopLeft;
+		// Size of the display wall in meters.
+		Vector2f myCanvasSize;
 	};
 }; // namespace omega
 
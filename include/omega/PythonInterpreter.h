@@ -61,7 +61,7 @@ namespace omega
 	public:
 		enum CallbackType
 		{
-			CallbackUpdate, CallbackEvent, CallbackDraw
+			CallbackUpdate, CallbackEvent, CallbackDraw, CallbackEventBatch
 		};
 
 		//! The flags that can be applied to the runFile method
@@ -107,13 +107,65 @@ namespace omega
 
 		//! Queues a command for execution. If the local flag is set, the command will be executed only on
 		//! the local node.
-		void queueCommand(const String& command, bool local = false);
+		//! @param key if not empty, the command replaces any pending command 
+		//! queued with the same key (latest value wins). Useful for commands
+		//! sent at high rate, like the ones generated by sliders or remote clients.
+		void queueCommand(const String& command, bool local = false, const String& key = "");
 
 		void registerCallback(void* callback, CallbackType type);
+		//! Registers a callback that receives all the events of a frame as a
+		//! single list, right before update callbacks are invoked. Bit n of
+		//! serviceTypeMask enables delivery of events with service type n.
+		//! @remarks Since batched events are delivered after all event 
+		//! processing, marking them as processed has no effect.
+		void registerEventBatchCallback(void* callback, uint serviceTypeMask = 0xffffffff);
 		void unregisterAllCallbacks();
 
 		void addPythonPath(const char*);
 
+		//! Compiled code cache
+		//@{
+		//! Sets the maximum number of command strings whose compiled code is
+		//! kept by eval. Least recently used commands are discarded first.
+		//! Setting the size to 0 disables the cache.
+		void setCodeCacheSize(int value);
+		int getCodeCacheSize() { return myCodeCacheSize; }
+		//! When enabled, each cached command gets its own execution time stat,
+		//! named 'py <command prefix> #<command hash>'.
+		void setCommandStatsEnabled(bool value);
+		bool isCommandStatsEnabled() { return myCommandStatsEnabled; }
+		//! Discards all compiled commands. Called automatically by clean().
+		void clearCodeCache();
+		//@}
+
+		//! When enabled, consecutive single-line queued commands are executed
+		//! as a single compiled block. Each command still runs in its own try
+		//! block, so a failing command does not stop the following ones.
+		void setCommandBatchingEnabled(bool value) { myCommandBatchingEnabled = value; }
+		bool isCommandBatchingEnabled() { return myCommandBatchingEnabled; }
+
+		//! Compiled script cache
+		//@{
+		//! Sets the directory used to store the compiled code of scripts run 
+		//! through runFile. Compiled scripts are keyed by path and modification
+		//! time, so a directory on a shared file system can be used by all the 
+		//! nodes of a cluster. An empty string disables the disk cache (compiled
+		//! scripts are still kept in memory, to speed up reloads).
+		void setScriptCacheDir(const String& value) { myScriptCacheDir = value; }
+		const String& getScriptCacheDir() { return myScriptCacheDir; }
+		//@}
+
+		//! Callback profiling
+		//@{
+		//! When enabled, each registered update, event and draw callback gets
+		//! its own time stat, named 'py <type> <module>.<function> #<index>'.
+		//! The index keeps stats of lambdas and same-named functions 
+		//! separate. The stat sample count and maximum give the number of 
+		//! calls and worst-case time.
+		void setCallbackStatsEnabled(bool value);
+		bool isCallbackStatsEnabled() { return myCallbackStatsEnabled; }
+		//@}
+
 		bool isEnabled();
 		bool isShellEnabled() { return myShellEnabled; }
 
@@ -130,12 +182,47 @@ namespace omega
 	protected:
 		struct QueuedCommand
 		{
-			QueuedCommand(const String& cmd, bool bneedsExecute, bool bneedsSend):
-				command(cmd), needsExecute(bneedsExecute), needsSend(bneedsSend)
+			QueuedCommand(const String& cmd, bool bneedsExecute, bool bneedsSend, const String& ckey = ""):
+				command(cmd), needsExecute(bneedsExecute), needsSend(bneedsSend), key(ckey)
 			{}
 			String command;
 			bool needsExecute;
 			bool needsSend;
+			// Coalescing key, see queueCommand
+			String key;
+		};
+
+		struct CompiledCommand
+		{
+			String command;
+			// The compiled code object (a PyObject*)
+			void* code;
+			Ref<Stat> stat;
+		};
+		typedef List<CompiledCommand*>::iterator CodeCacheIterator;
+
+		struct CompiledScript
+		{
+			long mtime;
+			long size;
+			// The compiled code object (a PyObject*)
+			void* code;
+		};
+
+		struct ScriptCallback
+		{
+			ScriptCallback(void* cb): callback(cb) {}
+			// The python callable (a PyObject*)
+			void* callback;
+			// Execution time stat, created when callback stats are enabled.
+			Ref<Stat> stat;
+		};
+
+		struct EventBatchCallback: public ScriptCallback
+		{
+			EventBatchCallback(void* cb, uint mask): 
+				ScriptCallback(cb), serviceTypeMask(mask) {}
+			uint serviceTypeMask;
 		};
 
 	protected:
@@ -150,9 +237,15 @@ namespace omega
 		Lock myInteractiveCommandLock;
 		List<QueuedCommand*> myCommandQueue;
 
-		List<void*> myUpdateCallbacks;
-		List<void*> myEventCallbacks;
-		List<void*> myDrawCallbacks;
+		List<ScriptCallback> myUpdateCallbacks;
+		List<ScriptCallback> myEventCallbacks;
+		List<ScriptCallback> myDrawCallbacks;
+		List<EventBatchCallback> myEventBatchCallbacks;
+		// Union of the service type masks of all event batch callbacks.
+		uint myEventBatchMask;
+		// Events received during the current frame, to be delivered to event
+		// batch callbacks.
+		Vector< Ref<Event> > myEventBatch;
 
 		//char* myExecutablePath;
 
@@ -162,11 +255,55 @@ namespace omega
 		
 		// Stats
 		Ref<Stat> myUpdateTimeStat;
+		// Number and size of the commands sent (on master) or received (on
+		// slaves) each frame.
+		Ref<Stat> myCommandCountStat;
+		Ref<Stat> myCommandBytesStat;
+		// Time spent loading or compiling scripts in runFile, and running 
+		// their top-level code.
+		Ref<Stat> myScriptLoadTimeStat;
+		Ref<Stat> myScriptRunTimeStat;
+
+		// Compiled code cache. The list is sorted from most to least recently
+		// used command.
+		List<CompiledCommand*> myCodeCache;
+		Dictionary<String, CodeCacheIterator> myCodeCacheIndex;
+		int myCodeCacheSize;
+		bool myCommandStatsEnabled;
+		bool myCallbackStatsEnabled;
+		// Number of callback stats created so far. Used to give each 
+		// callback stat a unique name.
+		int myCallbackStatCount;
+		bool myCommandBatchingEnabled;
 
+		// Compiled script cache, indexed by full script path.
+		Dictionary<String, CompiledScript> myScriptCache;
+		String myScriptCacheDir;
 
 	private:
 		void lockInterpreter();
 		void unlockInterpreter();
+		void deliverEventBatch();
+		//! Returns the time stat of a callback, creating it if needed.
+		Stat* getCallbackStat(ScriptCallback& cb, const char* type);
+		//! Runs a command using the compiled code cache. Must be called with
+		//! the interpreter locked.
+		void evalCompiled(const String& script);
+		//! Returns the code cache entry for a script, compiling it if needed.
+		//! Returns NULL with the python error set if the script cannot be 
+		//! compiled. Must be called with the interpreter locked.
+		CompiledCommand* getCompiledCommand(const String& script, const char* filename);
+		//! Runs a list of single-line python commands as one compiled block.
+		//! The block goes through the code cache when it is enabled.
+		void evalBatch(const Vector<String>& commands);
+		//! Returns the compiled code of a script file (as a new PyObject* 
+		//! reference), using the memory and disk script caches. Returns NULL
+		//! if the script cannot be read or compiled.
+		void* loadScript(const String& fullPath, const String& filename);
+		void clearScriptCache();
+		//! Removes least recently used commands until the cache contains at 
+		//! most maxSize commands.
+		void trimCodeCache(int maxSize);
 
 	private:
 		static const Event* mysLastEvent;
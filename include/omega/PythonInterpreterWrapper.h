@@ -98,6 +98,106 @@ using namespace boost::python;
 bool OMEGA_API isRefPtrForwardingEnabled();
 void OMEGA_API disableRefPtrForwarding();
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//! Gives in-place access to the memory of a python object supporting the buffer
+//! protocol (numpy arrays, bytearrays, array.array, strings for read access).
+//! Both the new and old style buffer interfaces are supported. The memory stays
+//! valid for the lifetime of the PythonBuffer object.
+class PythonBuffer: boost::noncopyable
+{
+public:
+	PythonBuffer(PyObject* obj, bool writable): 
+		myData(NULL), mySize(0), myFormat(NULL), myHasView(false)
+	{
+		if(obj == NULL || obj == Py_None) return;
+		if(PyObject_CheckBuffer(obj))
+		{
+			int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT;
+			if(writable) flags |= PyBUF_WRITABLE;
+			if(PyObject_GetBuffer(obj, &myView, flags) == 0)
+			{
+				myHasView = true;
+				myData = myView.buf;
+				mySize = myView.len;
+				// Only keep the format if it matches the item size, so 
+				// isFloat can trust it.
+				if(myView.itemsize == sizeof(float)) myFormat = myView.format;
+			}
+		}
+		else if(writable)
+		{
+			void* data;
+			Py_ssize_t len;
+			if(PyObject_AsWriteBuffer(obj, &data, &len) == 0) 
+			{
+				myData = data;
+				mySize = len;
+			}
+		}
+		else
+		{
+			const void* data;
+			Py_ssize_t len;
+			if(PyObject_AsReadBuffer(obj, &data, &len) == 0) 
+			{
+				myData = const_cast<void*>(data);
+				mySize = len;
+			}
+		}
+		// Errors are reported by the caller.
+		if(myData == NULL) PyErr_Clear();
+		// Old style buffers carry no format. The only one we can identify
+		// as float data is array.array('f') (which on python 2 does not
+		// support the new buffer interface).
+		else if(!myHasView) myFormat = getArrayFormat(obj);
+	}
+
+	~PythonBuffer() 
+	{ 
+		if(myHasView) PyBuffer_Release(&myView); 
+	}
+
+	bool isValid() { return myData != NULL; }
+	void* getData() { return myData; }
+	//! Returns the buffer size in bytes.
+	size_t getSize() { return mySize; }
+	//! Returns true if the buffer items are native 32 bit floats. Buffers 
+	//! without format information (strings, bytearrays, most old style
+	//! buffers) are rejected.
+	bool isFloat()
+	{
+		if(myFormat == NULL) return false;
+		const char* f = myFormat;
+		if(*f == '@' || *f == '=') f++;
+		return f[0] == 'f' && f[1] == '\0';
+	}
+
+private:
+	//! Returns "f" for array.array objects with a float typecode, NULL 
+	//! otherwise.
+	static const char* getArrayFormat(PyObject* obj)
+	{
+		const char* format = NULL;
+		PyObject* typecode = PyObject_GetAttrString(obj, "typecode");
+		if(typecode != NULL)
+		{
+			if(PyString_Check(typecode) && strcmp(PyString_AsString(typecode), "f") == 0) format = "f";
+			Py_DECREF(typecode);
+		}
+		else
+		{
+			PyErr_Clear();
+		}
+		return format;
+	}
+
+	void* myData;
+	size_t mySize;
+	const char* myFormat;
+	bool myHasView;
+	Py_buffer myView;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // SMART POINTER WRAPPING CODE FROM http://isolation-nation.blogspot.com/2008/09/returnbysmartptr-policy-for-boost.html
 // attempting to instantiate this type will result in a compiler error,
@@ -70,6 +70,19 @@ namespace omega
 		void clear();
 		//@}
 
+		//! Asynchronous readback
+		//@{
+		//! When enabled, color readbacks are copied into alternating pixel 
+		//! pack buffers instead of stalling the GPU pipeline. The readback 
+		//! color target receives the pixels for frame N during the readback
+		//! of frame N+1. Depth readbacks are always synchronous.
+		void setAsyncReadback(bool value) { myAsyncReadback = value; }
+		bool isAsyncReadback() { return myAsyncReadback; }
+		//! Returns the time in milliseconds between the issue and the delivery
+		//! of the last asynchronous readback.
+		float getReadbackLatency() { return myReadbackLatency; }
+		//@}
+
 		GLuint getId() { return myId; };
 		virtual void dispose();
 
@@ -78,6 +91,11 @@ namespace omega
 		RenderTarget(GpuContext* context, Type type, GLuint id = 0);
 		~RenderTarget();
 
+	private:
+		void readbackColorAsync();
+		void releaseReadbackBuffers();
+		void updateGpuMemorySize();
+
 	private:
 		GLuint myId;
 		Type myType;
@@ -96,6 +114,18 @@ namespace omega
 		PixelData* myReadbackColorTarget;
 		PixelData* myReadbackDepthTarget;
 		Rect myReadbackViewport;
+
+		// Asynchronous readback stuff
+		bool myAsyncReadback;
+		GLuint myReadbackPbo[2];
+		// GLsync objects. Stored as void pointers to avoid including the GL
+		// headers here.
+		void* myReadbackFence[2];
+		double myReadbackIssueTime[2];
+		int myReadbackIndex;
+		size_t myReadbackPboSize;
+		float myReadbackLatency;
+		Timer myReadbackTimer;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -86,6 +86,20 @@ namespace omega {
 		RenderTarget* createRenderTarget(RenderTarget::Type type);
 		//@}
 
+		//! GPU memory management
+		//@{
+		//! Sets the GPU memory budget for resources owned by this renderer, 
+		//! in bytes. When the budget is exceeded, the least recently used 
+		//! evictable resources (textures generated by a TextureSource) are 
+		//! released. They will be re-created when used again. 
+		//! A value of 0 (the default) disables the budget.
+		void setGpuMemoryBudget(size_t value) { myGpuMemoryBudget = value; }
+		size_t getGpuMemoryBudget() { return myGpuMemoryBudget; }
+		//! Returns the estimated GPU memory used by resources owned by this
+		//! renderer, in bytes.
+		size_t getGpuMemoryUsage() { return myGpuContext->getGpuMemoryUsage(); }
+		//@}
+
 	private:
 		void innerDraw(const DrawContext& context, Camera* camera);
 
@@ -102,10 +116,12 @@ namespace omega {
 		List< Ref<RenderPass> > myRenderPassList;
 		Queue< Ref<IRendererCommand> > myRenderableCommands;
 
-		List< Ref<GpuResource> > myResources;
+		size_t myGpuMemoryBudget;
 
 		// Stats
 		Ref<Stat> myFrameTimeStat;
+		Ref<Stat> myGpuMemoryStat;
+		Ref<Stat> myEvictionsStat;
 	};
 
 	///////////////////////////////////////////////////////////////////////////
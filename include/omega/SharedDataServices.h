@@ -28,6 +28,7 @@
 #define __SHARED_DATA_SERVICES__
 
 #include "omega/osystem.h"
+#include "omega/ApplicationBase.h"
 
 namespace co
 {
@@ -37,14 +38,16 @@ namespace co
 
 namespace omega
 {
-	class SharedData;
 	class EngineModule;
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
     class OMEGA_API SharedOStream
     {
     public:
-		SharedOStream(co::DataOStream* stream): myStream(stream) {}
+		SharedOStream(co::DataOStream* stream): myStream(stream), myBuffer(NULL) {}
+		//! Creates a stream that appends data to a memory buffer. Used by
+		//! transports that do not go through Equalizer.
+		SharedOStream(Vector<char>* buffer): myStream(NULL), myBuffer(buffer) {}
 
         template< typename T > SharedOStream& operator << ( const T& value )
         { write( &value, sizeof( value )); return *this; }
@@ -53,17 +56,24 @@ namespace omega
 	
 		void write( const void* data, uint64_t size );
 
+		//! Returns the Equalizer stream this object writes to, or NULL for
+		//! memory streams.
 		co::DataOStream* getInternalStream() { return myStream; }
 	
 	private:
 		co::DataOStream* myStream;
+		Vector<char>* myBuffer;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
     class OMEGA_API SharedIStream
     {
     public:
-		SharedIStream(co::DataIStream* stream): myStream(stream) {}
+		SharedIStream(co::DataIStream* stream): 
+			myStream(stream), myData(NULL), mySize(0), myPosition(0) {}
+		//! Creates a stream that reads data from a memory buffer.
+		SharedIStream(const char* data, size_t size): 
+			myStream(NULL), myData(data), mySize(size), myPosition(0) {}
 
         template< typename T >
         SharedIStream& operator >> ( T& value )
@@ -73,10 +83,18 @@ namespace omega
 	
 		void read( void* data, uint64_t size );
 	
+		//! Returns the number of bytes that can still be read from the stream.
+		uint64_t getRemainingBufferSize();
+
+		//! Returns the Equalizer stream this object reads from, or NULL for
+		//! memory streams.
 		co::DataIStream* getInternalStream() { return myStream; }
 
 	private:
 		co::DataIStream* myStream;
+		const char* myData;
+		size_t mySize;
+		size_t myPosition;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -87,17 +105,44 @@ namespace omega
 		virtual void updateSharedData(SharedIStream& in) {}
 	};
 
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	//! Stores the objects registered for data sharing, and serializes them 
+	//! (together with the frame update context) to and from shared streams.
+	//! Shared data transports (like the Equalizer shared data object) derive
+	//! from this class.
+	class OMEGA_API SharedObjectRegistry
+	{
+	public:
+		virtual ~SharedObjectRegistry() {}
+
+		void registerObject(SharedObject* object, const String& id);
+		void unregisterObject(const String& id);
+
+		void setUpdateContext(const UpdateContext& ctx) { myUpdateContext = ctx; }
+		const UpdateContext& getUpdateContext() { return myUpdateContext; }
+
+		//! Writes the update context and the data of all registered objects.
+		void serializeObjects(SharedOStream& out);
+		//! Reads the update context and dispatches shared data to the 
+		//! registered objects.
+		void deserializeObjects(SharedIStream& in);
+
+	private:
+		Dictionary<String, SharedObject*> myObjects;
+		UpdateContext myUpdateContext;
+	};
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	class OMEGA_API SharedDataServices
 	{
 	public:
-		static void setSharedData(SharedData* data);
+		static void setSharedData(SharedObjectRegistry* data);
 		static void registerObject(SharedObject*, const String& id);
 		static void unregisterObject(const String& id);
 		static void cleanup();
 
 	private:
-		static SharedData* mysSharedData;
+		static SharedObjectRegistry* mysSharedData;
 		static Dictionary<String, SharedObject*> mysRegistrationQueue;
 	};
 }; // namespace omega
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	A shared memory ring buffer used to send frame data from one omegalib 
+ *  instance to other instances running on the same machine.
+ ******************************************************************************/
+#ifndef __SHARED_MEMORY_RING_H__
+#define __SHARED_MEMORY_RING_H__
+
+#include "omega/osystem.h"
+
+namespace omega
+{
+    ///////////////////////////////////////////////////////////////////////////
+    //! A single-writer, multiple-reader ring of variable-size frames stored 
+    //! in a named shared memory segment.
+    //! The writer (usually the master instance) creates the ring and publishes
+    //! frames with write(). Each reader opens the ring using a unique reader
+    //! index, and receives every frame in order through read(). The writer 
+    //! never overwrites a frame that an active reader has not read yet: when
+    //! the ring is full, write() waits for the slowest reader. Readers that do
+    //! not consume frames before the write timeout are considered dead and
+    //! are detached.
+    //! Readers can report per-frame statistics back to the writer through the
+    //! ring (see setReaderStats).
+    class OMEGA_API SharedMemoryRing: public ReferenceType
+    {
+    public:
+        static const int MaxReaders = 64;
+
+        //! Creates a new ring and its shared memory segment. If a segment with
+        //! the same name exists, it is replaced.
+        //! @return the new ring, or NULL if the segment could not be created.
+        static SharedMemoryRing* create(const String& name, 
+            uint numSlots, size_t slotSize, uint numReaders);
+        //! Opens an existing ring for reading. Waits up to timeout seconds for 
+        //! the writer to create the ring. If sessionToken is not zero, the 
+        //! ring is only accepted if the writer set the same token (see 
+        //! setSessionToken).
+        //! @return the ring, or NULL if it could not be opened, if the 
+        //! writer does not expect a reader with this index or if the ring
+        //! belongs to a different session.
+        static SharedMemoryRing* open(const String& name, uint readerIndex,
+            double timeout, uint64 sessionToken = 0);
+
+        //! Returns a system-wide time in seconds. Times returned by this 
+        //! function can be compared across processes on the same machine.
+        static double getTime();
+
+    public:
+        virtual ~SharedMemoryRing();
+
+        //! Writer: sets whether the reader with the specified index is 
+        //! allowed to open the ring. All readers are expected by default.
+        void setReaderExpected(uint index, bool expected);
+        //! Writer: sets a token identifying the current session. Readers 
+        //! passing a token to open reject rings with a different token, so a
+        //! stale segment left by a crashed instance is not taken for a live
+        //! ring.
+        void setSessionToken(uint64 token);
+        //! Writer: returns the number of readers allowed to open the ring.
+        int getNumExpectedReaders();
+        //! Writer: waits up to timeout seconds for all the expected readers
+        //! to open the ring. Returns true if all readers are attached.
+        bool waitForReaders(double timeout);
+        //! Writer: publishes a frame. The frame is timestamped using getTime.
+        //! @return false if the frame is bigger than the slot size.
+        bool write(const void* data, size_t size, double timeout);
+        //! Writer: tells readers no more frames will be sent.
+        void shutdown();
+        //! Writer: returns the number of readers currently attached.
+        int getNumActiveReaders();
+        //! Writer: returns the maximum value of the statistics reported by 
+        //! active readers for their last frame.
+        void getReaderStats(float& maxApplyTime, float& maxLatency);
+
+        //! Reader: reads the next frame. Returns false if no frame is 
+        //! available within timeout seconds, or if the writer shut the ring 
+        //! down.
+        bool read(Vector<char>& data, double& timestamp, double timeout);
+        //! Reader: stores statistics about the last frame processed by this 
+        //! reader. Times are in milliseconds.
+        void setReaderStats(float applyTime, float latency);
+        //! Reader: detaches this reader from the ring.
+        void close();
+
+        bool isWriter() { return myIsWriter; }
+        bool isShutdown();
+        const String& getName() { return myName; }
+        size_t getSlotSize();
+        uint64 getFramesWritten();
+
+    private:
+        SharedMemoryRing();
+        bool mapSegment(size_t size, bool create);
+        void unmapSegment();
+        char* getSlot(uint64 frame);
+
+    private:
+        String myName;
+        bool myIsWriter;
+        uint myReaderIndex;
+        void* myMemory;
+        size_t myMemorySize;
+#ifdef OMEGA_OS_WIN
+        void* myHandle;
+#else
+        int myHandle;
+#endif
+    };
+}; // namespace omega
+
+#endif
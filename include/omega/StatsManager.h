@@ -42,6 +42,8 @@ namespace omega
 {
     class DrawInterface;
     class Stat;
+    class ClusterStat;
+    struct StatSummary;
 
     ///////////////////////////////////////////////////////////////////////////
     class OMEGA_API StatsManager: public ReferenceType
@@ -57,12 +59,43 @@ namespace omega
         List<Stat*>::Range getStats();
         void printStats();
 
+        //! Cluster stats
+        //! On cluster configurations, the master receives periodic summaries
+        //! of the stats running on each node and aggregates them by stat name.
+        //@{
+        //! Adds or updates the summary of a stat running on the specified node.
+        ClusterStat* updateClusterStat(const String& name, const String& node, const StatSummary& summary);
+        //! Summarizes all the valid local stats as belonging to the specified 
+        //! node. Used by the master to add its own stats to the cluster stats.
+        void updateClusterStats(const String& node);
+        ClusterStat* findClusterStat(const String& name);
+        List< Ref<ClusterStat> >::Range getClusterStats();
+        //@}
+
     private:
         Dictionary<String, Stat*> myStatDictionary;
         // List of stats. Stats are normal pointers, since we want to leave
         // stat ownership to user code. When a stat reference count goes to
         // zero, the stat will remove itself from this list.
         List< Stat* > myStatList;
+
+        // Cluster stats are owned by the stats manager.
+        Dictionary<String, ClusterStat*> myClusterStatDictionary;
+        List< Ref<ClusterStat> > myClusterStatList;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    //! Compact summary of a stat. Cluster nodes send these to the master.
+    struct StatSummary
+    {
+        StatsManager::StatType type;
+        int numSamples;
+        float cur;
+        float min;
+        float max;
+        float avg;
+        //! 99th percentile of the most recent samples.
+        float p99;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -100,6 +133,13 @@ namespace omega
         float getMax();
         float getAvg();
         float getTotal();
+        //! Returns the value below which the specified fraction (0 - 1) of 
+        //! samples fall. Computed over the last WindowSize samples.
+        float getPercentile(float fraction);
+        void getSummary(StatSummary& summary);
+
+        //! Number of recent samples kept for percentile computation.
+        static const int WindowSize = 128;
 
     private:
         Stat(StatsManager* owner, const String& name, StatsManager::StatType type): 
@@ -116,10 +156,58 @@ namespace omega
         int myNumSamples;
         double myAccumulator;
         StatsManager::StatType myType;
+        // Circular buffer of the most recent samples.
+        float myWindow[WindowSize];
 
         Timer myTimer;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    //! Aggregated view of a stat over all the nodes of a cluster. 
+    class OMEGA_API ClusterStat: public ReferenceType
+    {
+    public:
+        typedef Dictionary<String, StatSummary> NodeSummaries;
+
+    public:
+        ClusterStat(const String& name, StatsManager::StatType type):
+            myName(name), myType(type), myMinAvg(0), myMaxAvg(0), myAvg(0), 
+            myMedianAvg(0), myMaxP99(0) {}
+
+        const String& getName() { return myName; }
+        StatsManager::StatType getType() { return myType; }
+
+        void update(const String& node, const StatSummary& summary);
+        //! Returns the latest summary received from each node.
+        NodeSummaries& getNodeSummaries() { return myNodes; }
+        int getNumNodes() { return (int)myNodes.size(); }
+
+        //! Lowest, highest, mean and median of the node averages.
+        float getMinAvg() { return myMinAvg; }
+        float getMaxAvg() { return myMaxAvg; }
+        float getAvg() { return myAvg; }
+        float getMedianAvg() { return myMedianAvg; }
+        //! Highest 99th percentile across nodes.
+        float getMaxP99() { return myMaxP99; }
+        //! Returns the node with the highest average. For time stats, this
+        //! is the node most likely to be holding back the rest of the cluster.
+        const String& getOutlierNode() { return myOutlierNode; }
+        //! Returns true if the outlier node average exceeds the median node 
+        //! average by more than the specified fraction.
+        bool hasOutlier(float threshold = 0.25f);
+
+    private:
+        String myName;
+        StatsManager::StatType myType;
+        NodeSummaries myNodes;
+        float myMinAvg;
+        float myMaxAvg;
+        float myAvg;
+        float myMedianAvg;
+        float myMaxP99;
+        String myOutlierNode;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     inline void Stat::startTiming()
     {
@@ -169,6 +257,7 @@ namespace omega
             if(sample > myMax) myMax = sample;
             myAvg = myAccumulator / myNumSamples;
         }
+        myWindow[(myNumSamples - 1) % WindowSize] = (float)sample;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -202,6 +291,10 @@ namespace omega
     ///////////////////////////////////////////////////////////////////////////
     inline float Stat::getTotal()
     { oassert(myValid); return myAccumulator;	}
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline bool ClusterStat::hasOutlier(float threshold)
+    { return myNodes.size() > 1 && myMaxAvg > myMedianAvg * (1 + threshold); }
 }; // namespace omega
 
 #endif
\ No newline at end of file
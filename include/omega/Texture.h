@@ -63,14 +63,35 @@ namespace omega
 		GpuContext::TextureUnit getTextureUnit();
 		//@}
 
+		//! Eviction support
+		//@{
+		//! Marks this texture as re-creatable from its source data. Only
+		//! evictable textures are released when the renderer goes over its
+		//! GPU memory budget.
+		void setEvictable(bool value) { myEvictable = value; }
+		virtual bool isEvictable() { return myEvictable && myInitialized; }
+		virtual void evict();
+		//! Returns true if this texture has been evicted and needs to be
+		//! re-initialized before use.
+		bool isEvicted() { return myEvicted; }
+		//@}
+
+		virtual void dispose();
+
 	protected:
 		// Only renderer can allocate textures.
 		Texture(GpuContext* context);
+		~Texture();
+
+	private:
+		void updateGpuMemorySize();
 
 	private:
 		static bool sUsePbo;
 
 		bool myInitialized;
+		bool myEvictable;
+		bool myEvicted;
 		GLuint myId;
 		int myWidth;
 		int myHeight;
@@ -55,6 +55,12 @@ namespace omega {
 		// Only pointer events from this service will be processed.
 		Service* myInputService;
 		bool myHasNormalizedInput;
+
+		// Pointer events processed in the current poll, converted in a 
+		// single batch.
+		Vector<Event*> myPointerEvents;
+		Vector<Vector2i> myPointerPositions;
+		Vector<Ray> myPointerRays;
 	};
 }; // namespace omega
 
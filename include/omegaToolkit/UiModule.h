@@ -75,6 +75,12 @@ namespace omegaToolkit
 		//! Defaults to true.
 		void setCullingEnabled(bool value) { myCullingEnabled = value; }
 		bool isCullingEnabled() { return myCullingEnabled; }
+		//! Enables or disables the container hit test index. When enabled, 
+		//! containers route pointer events only to the widgets under the
+		//! pointer, instead of sending them to all their children.
+		//! Defaults to true.
+		void setHitTestIndexEnabled(bool value) { myHitTestIndexEnabled = value; }
+		bool isHitTestIndexEnabled() { return myHitTestIndexEnabled; }
 
 		void activateWidget(ui::Widget* w);
 
@@ -102,6 +108,7 @@ namespace omegaToolkit
 		bool myLocalEventsEnabled;
 
 		bool myCullingEnabled;
+		bool myHitTestIndexEnabled;
 
 		Ref<ui::Widget> myActiveWidget;
 		Ref<ui::Container> myUi;
@@ -115,6 +122,10 @@ namespace omegaToolkit
 		};
 
 		List< Ref<ExtendedUiData> > myExtendedUiList;
+
+		// Stats
+		Ref<Stat> myLayoutTimeStat;
+		Ref<Stat> myPointerDispatchTimeStat;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -40,13 +40,13 @@ namespace omegaToolkit { namespace ui {
 		virtual void update(const omega::UpdateContext& context);
 
 		bool isCheckable() { return myCheckable; }
-		void setCheckable(bool value) { myCheckable = value; }
+		void setCheckable(bool value) { myCheckable = value; requestLayoutRefresh(); }
 
 		bool isRadio() { return myRadio; }
-		void setRadio(bool value)  { myRadio = value; }
+		void setRadio(bool value)  { myRadio = value; requestRedraw(); }
 
 		bool isChecked() { return myChecked; }
-		void setChecked(bool value) { myChecked = value; }
+		void setChecked(bool value) { if(myChecked != value) { myChecked = value; requestRedraw(); } }
 
 		bool isPressed() { return myPressed; }
 
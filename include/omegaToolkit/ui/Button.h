@@ -60,7 +60,7 @@ namespace omegaToolkit { namespace ui {
 		PixelData* getIcon() { return myImage.getData(); }
 
 		Image* getImage() { return &myImage; }
-		void setImageEnabled(bool value) { myImageEnabled = true; }
+		void setImageEnabled(bool value) { myImageEnabled = true; requestLayoutRefresh(); }
 		bool isImageEnabled() { return myImageEnabled; }
 
 		// Gets the label subobject used by the button.
@@ -77,6 +77,9 @@ namespace omegaToolkit { namespace ui {
 		Image myImage;
 		Color myColor;
 		bool myImageEnabled;
+		// Sum of the label and image redraw versions, used to detect changes
+		// to the button subobjects (that are not part of a container)
+		uint mySubobjectRedrawVersion;
 	};
 
 	///////////////////////////////////////////////////////////////////////////
@@ -138,6 +138,11 @@ namespace omegaToolkit { namespace ui {
         //! For 3D mode containers: converts a ray event to a pointer event with 2D coordintes in the container coordinate space.
         //! Returns true if the event happens within the container boundaries, and could be converted to a pointer event successfully.
         bool rayToPointerEvent(const Event& inEvt, Event& outEvt);
+        //! For 3D mode containers: converts count world space rays to 2D 
+        //! points in the container coordinate space. The container plane is
+        //! computed once for the whole batch. 
+        //! @returns the number of rays intersecting the container plane.
+        int raysToPointers(const Ray* rays, int count, std::pair<bool, Vector2f>* points);
 
         virtual void layout();
 
@@ -165,13 +170,23 @@ namespace omegaToolkit { namespace ui {
         virtual void activate();
 
     private:
-        int expandStep(int childSpace, Orientation orientation);
+        int expandStep(int childSpace, Orientation orientation, bool& expanded);
         void updateChildrenLayoutPosition(Orientation orientation);
         void updateChildrenFreeBounds(Orientation orientation);
         void resetChildrenSize(Orientation orientation);
         void computeLinearLayout(Orientation orientation);
         void computeGridLayout(Orientation orientation);
 
+        //! Pointer event routing
+        //@{
+        //! Sends an event to the children of this container. Pointer events
+        //! are only sent to children under the pointer, using the hit test index.
+        void dispatchToChildren(const Event& evt);
+        //! Rebuilds the hit test index if the container or any of its 
+        //! descendants changed since the last update.
+        void updateHitTestIndex();
+        //@}
+
     private:
         List< Ref<Widget> > myChildren;
         Layout myLayout;
@@ -187,19 +202,54 @@ namespace omegaToolkit { namespace ui {
 
         Ref<PixelData> myPixels;
         bool myPixelOutputEnabled;
+
+        // Hit test index: a uniform grid over the child bounds, used to
+        // route pointer events only to the children under the pointer.
+        struct HitTestEntry
+        {
+            // The child index, used to preserve the original dispatch order.
+            int index;
+            Widget* widget;
+            // Child bounds (including its descendants) in container coordinates.
+            Vector2f min;
+            Vector2f max;
+            bool operator<(const HitTestEntry& other) const { return index < other.index; }
+        };
+        static const int MaxHitTestGridSize = 32;
+        bool myHitTestIndexValid;
+        uint myHitTestIndexVersion;
+        // Bounds of this container and all its descendants, in container 
+        // coordinates.
+        Vector2f myBoundsMin;
+        Vector2f myBoundsMax;
+        int myHitTestGridSize;
+        Vector2f myHitTestCellSize;
+        Vector< Vector<HitTestEntry> > myHitTestCells;
+        // Children that can't be indexed (i.e. rotated widgets) and always
+        // receive pointer events.
+        Vector<HitTestEntry> myHitTestUnindexed;
+        // Child containers: they get pointer events when in 3D mode, 
+        // regardless of their bounds.
+        Vector<HitTestEntry> myHitTestContainers;
     };
 
     ////////////////////////////////////////////////////////////////////////////
     class OTK_API ContainerRenderable: public WidgetRenderable
     {
     public:
-        ContainerRenderable(Container* owner): WidgetRenderable(owner), myOwner(owner), myRenderTarget(NULL), myTexture(NULL) {}
+        ContainerRenderable(Container* owner): WidgetRenderable(owner), myOwner(owner), myRenderTarget(NULL), myTexture(NULL), myRenderedVersion(0), myRenderedFrame(0) {}
         virtual void draw(const DrawContext& context);
 
     protected:
         void draw3d(const DrawContext& context);
         void drawChildren(const DrawContext& context, bool containerOnly);
-        void beginDraw(const DrawContext& context);
+        //! Sets up drawing for this container. For containers rendered to
+        //! a texture (3D or pixel output mode), returns false if the container
+        //! content did not change since the frame it was last rendered in, 
+        //! and the cached texture can be reused. In this case endDraw should
+        //! not be called. All draw passes (eyes) of the frame in which the
+        //! container changed render it.
+        bool beginDraw(const DrawContext& context);
         void endDraw(const DrawContext& context);
 
     private:
@@ -209,6 +259,13 @@ namespace omegaToolkit { namespace ui {
         // Stuff used for 3d ui rendering.
         Ref<RenderTarget> myRenderTarget;
         Ref<Texture> myTexture;
+        // Redraw version of the owner container when it was last rendered
+        // to the render target.
+        uint myRenderedVersion;
+        // Frame in which myRenderedVersion was first rendered. Stereo 
+        // configurations draw the overlay once per eye, and children only 
+        // draw in the cyclop pass, so we keep rendering for the whole frame.
+        uint64 myRenderedFrame;
     };
 
     ////////////////////////////////////////////////////////////////////////////
@@ -217,7 +274,7 @@ namespace omegaToolkit { namespace ui {
 
     ////////////////////////////////////////////////////////////////////////////
     inline void Container::setLayout(Layout layout) 
-    { myLayout = layout; }
+    { myLayout = layout; requestLayoutRefresh(); }
 
     ////////////////////////////////////////////////////////////////////////////
     inline Container::Layout Container::getLayout() 
@@ -265,11 +322,11 @@ namespace omegaToolkit { namespace ui {
 
     ////////////////////////////////////////////////////////////////////////////
     inline void Container::setGridRows(int value)
-    { myGridRows = value; }
+    { myGridRows = value; requestLayoutRefresh(); }
 
     ////////////////////////////////////////////////////////////////////////////
     inline void Container::setGridColumns(int value)
-    { myGridColumns = value; }
+    { myGridColumns = value; requestLayoutRefresh(); }
 
     ///////////////////////////////////////////////////////////////////////////
     inline bool Container::isIn3DContainer()
@@ -94,6 +94,11 @@ namespace omegaToolkit { namespace ui {
 
 		int myAutosizeHorizontalPadding;
 		int myAutosizeVerticalPadding;
+
+		// Cached text size, recomputed by autosize only when the label text 
+		// or font change.
+		Vector2f myTextSize;
+		bool myTextSizeValid;
 	};
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -123,8 +128,12 @@ namespace omegaToolkit { namespace ui {
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setText(const String& value) 
 	{ 
-		myText = value; 
-		requestLayoutRefresh();
+		if(myText != value)
+		{
+			myText = value; 
+			myTextSizeValid = false;
+			requestLayoutRefresh();
+		}
 	}
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
@@ -133,7 +142,7 @@ namespace omegaToolkit { namespace ui {
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setFont(const String& value)
-	{ myFont = value; refresh(); requestLayoutRefresh(); }
+	{ myFont = value; myTextSizeValid = false; refresh(); requestLayoutRefresh(); }
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline Color Label::getColor()
@@ -141,7 +150,13 @@ namespace omegaToolkit { namespace ui {
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setColor(const Color& value)
-	{ myColor = value; }
+	{ 
+		if(myColor != value)
+		{
+			myColor = value; 
+			requestRedraw();
+		}
+	}
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline Label::HorizontalAlign Label::getHorizontalAlign()
@@ -149,7 +164,7 @@ namespace omegaToolkit { namespace ui {
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setHorizontalAlign(HorizontalAlign value) 
-	{ myHorizontalAlign = value; }
+	{ myHorizontalAlign = value; requestRedraw(); }
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline Label::VerticalAlign Label::getVerticalAlign() 
@@ -157,15 +172,15 @@ namespace omegaToolkit { namespace ui {
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setVerticalAlign(VerticalAlign value) 
-	{ myVerticalAlign = value; }
+	{ myVerticalAlign = value; requestRedraw(); }
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setAutosizeVerticalPadding(int value) 
-	{ myAutosizeVerticalPadding = value; }
+	{ myAutosizeVerticalPadding = value; requestLayoutRefresh(); }
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline void Label::setAutosizeHorizontalPadding(int value) 
-	{ myAutosizeHorizontalPadding = value; }
+	{ myAutosizeHorizontalPadding = value; requestLayoutRefresh(); }
 
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	inline int Label::getAutosizeVerticalPadding() 
@@ -88,7 +88,13 @@ namespace omegaToolkit { namespace ui {
 
 	///////////////////////////////////////////////////////////////////////////
 	inline void Slider::setValue(int value) 
-	{ myValue = value; }
+	{ 
+		if(myValue != value)
+		{
+			myValue = value; 
+			requestRedraw();
+		}
+	}
 
 	///////////////////////////////////////////////////////////////////////////
 	inline int Slider::getTicks() 
@@ -96,7 +102,7 @@ namespace omegaToolkit { namespace ui {
 
 	///////////////////////////////////////////////////////////////////////////
 	inline void Slider::setTicks(int value) 
-	{ myTicks = value; }
+	{ myTicks = value; requestRedraw(); }
 
 	///////////////////////////////////////////////////////////////////////////
 	inline void Slider::setDeferUpdate(bool value)
@@ -90,7 +90,7 @@ namespace omegaToolkit {
         Vector2f getCenter();
         //! Sets the widget rotation
         //! @param value - the widget rotation in degrees
-        void setRotation(float value) { myRotation = value; }
+        void setRotation(float value) { if(myRotation != value) { myRotation = value; requestRedraw(); } }
         //! Gets the widget position.
         float getRotation() { return myRotation; }
         //@}
@@ -141,7 +141,7 @@ namespace omegaToolkit {
         int getId();
         virtual void layout();
 
-        void setStereo(bool value) { myStereo = value; }
+        void setStereo(bool value) { myStereo = value; requestRedraw(); }
         bool isStereo() { return myStereo; }
 
         //! Navigation
@@ -164,23 +164,34 @@ namespace omegaToolkit {
         virtual void updateSize();
         void requestLayoutRefresh();
 
+        //! Retained rendering
+        //@{
+        //! Marks this widget as changed. The change is propagated up to the
+        //! widget containers, so containers rendered to a texture (3D or pixel
+        //! output containers) know they need to re-render their content.
+        void requestRedraw();
+        //! Returns a counter that is incremented every time this widget or 
+        //! one of its descendants changes appearance.
+        uint getRedrawVersion() { return myRedrawVersion; }
+        //@}
+
         //! Appearance
         //@{
         void setStyle(const String& style);
         String getStyleValue(const String& key, const String& defaultValue = "");
         void setStyleValue(const String& key, const String& value);
-        void setScale(float value) { myScale = value; }
+        void setScale(float value) { if(myScale != value) { myScale = value; requestRedraw(); } }
         //! Sets the widget scale. Scale controls the visual appearance of a 
         //! widget without changing its actual size or forcing a layout refresh 
         //! of the widget container. Scale is indicated as a proportion of the
         //! current widget size.
         float getScale() { return myScale; }
-        void setAlpha(float value) { myAlpha = value; }
+        void setAlpha(float value) { if(myAlpha != value) { myAlpha = value; requestRedraw(); } }
         float getAlpha();
-        void setBlendMode(BlendMode value) { myBlendMode = value; }
+        void setBlendMode(BlendMode value) { myBlendMode = value; requestRedraw(); }
         BlendMode getBlendMode() { return myBlendMode; }
-        void setFillColor(const Color& c) { myFillColor = c; }
-        void setFillEnabled(bool value) { myFillEnabled = value; }
+        void setFillColor(const Color& c) { myFillColor = c; requestRedraw(); }
+        void setFillEnabled(bool value) { myFillEnabled = value; requestRedraw(); }
         //! Enables or disables shaders for this widget. Shaders are enabled
         //! by default and are required to correctly render some widget features
         //! like correct transparency. The shader used by the widget can be 
@@ -197,7 +208,7 @@ namespace omegaToolkit {
         //@}
 
         Layer getLayer() { return myLayer; }
-        void setLayer(Layer layer) { myLayer = layer; }
+        void setLayer(Layer layer) { myLayer = layer; requestRedraw(); }
 
         //! Returns true if the point is within this widget's bounding box.
         bool hitTest(const Vector2f& point);
@@ -225,12 +236,12 @@ namespace omegaToolkit {
         //! Gets the color used when widget debug mode is enabled.
         Color getDebugColor() { return myDebugModeColor; }
         //! Sets the color used when widget debug mode is enabled.
-        void setDebugColor( omega::Color value ) { myDebugModeColor = value; }
+        void setDebugColor( omega::Color value ) { myDebugModeColor = value; requestRedraw(); }
         //! Returns true if debug mode is enabled for this widget.
         bool isDebugModeEnabled() { return myDebugModeEnabled; }
         //! Enabled or disabled debug mode for this widget.
         //! When debug mode is enabled, the widget bounding box will be displayed.
-        void setDebugModeEnabled(bool value) { myDebugModeEnabled = value; }
+        void setDebugModeEnabled(bool value) { myDebugModeEnabled = value; requestRedraw(); }
 
         //@}
     protected:
@@ -288,6 +299,7 @@ namespace omegaToolkit {
         Ref<UiScriptCommand> myUiEventCommand;
 
         bool myNeedLayoutRefresh;
+        uint myRedrawVersion;
 
         // Debug mode.
         bool myDebugModeEnabled;
@@ -519,11 +531,18 @@ namespace omegaToolkit {
 
     ///////////////////////////////////////////////////////////////////////////
     inline void Widget::setVisible(bool value) 
-    { myVisible = value; }
+    { 
+        if(myVisible != value)
+        {
+            myVisible = value; 
+            requestRedraw();
+        }
+    }
 
     ///////////////////////////////////////////////////////////////////////////
     inline void Widget::setActive(bool value) 
     {
+        if(myActive != value) requestRedraw();
         myActive = value; 
         //if(myActive != value)
         {
@@ -545,9 +564,10 @@ namespace omegaToolkit {
                     value - myPosition);
             }
         }
-        else 
+        else if(myPosition != value)
         {
             myPosition = value; 
+            requestRedraw();
         }
     }
 
@@ -566,9 +586,10 @@ namespace omegaToolkit {
                 }
             }
         }
-        else
+        else if(myPosition[dimension] != value)
         {
             myPosition[dimension] = value; 
+            requestRedraw();
         }
     }
 
@@ -576,6 +597,7 @@ namespace omegaToolkit {
     inline void Widget::setShaderName(const String& name)
     {
         myShaderName = name;
+        requestRedraw();
         // Refresh the widget, so its renderables will load the new shader.
         refresh();
     }
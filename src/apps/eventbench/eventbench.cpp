@@ -0,0 +1,118 @@
+/********************************************************************************************************************** 
+ * THE OMEGA LIB PROJECT
+ *---------------------------------------------------------------------------------------------------------------------
+ * Copyright 2010-2014							Electronic Visualization Laboratory, University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti							febret@gmail.com
+ *---------------------------------------------------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory, University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the 
+ * following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this list of conditions and the following 
+ * disclaimer. Redistributions in binary form must reproduce the above copyright notice, this list of conditions 
+ * and the following disclaimer in the documentation and/or other materials provided with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, 
+ * INCLUDING, BUT NOT LIMITED TO THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE 
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, 
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE 
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *---------------------------------------------------------------------------------------------------------------------
+ *	eventbench
+ *		Measures the size and encoding / decoding speed of the event encodings used to share events with cluster 
+ *		nodes (see EventUtils). The benchmark encodes batches of tracker-like events, the way EventSharingModule 
+ *		does every frame.
+ *********************************************************************************************************************/
+#include <omega.h>
+#include "omega/EventUtils.h"
+
+using namespace omega;
+using namespace omicron;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void runBenchmark(const char* name, Event* events, int numEvents, int iterations, bool compact, bool quantize)
+{
+	Vector<char> buffer;
+	EventUtils::CompactContext context;
+	context.quantizeOrientation = quantize;
+
+	Timer timer;
+	timer.start();
+	for(int i = 0; i < iterations; i++)
+	{
+		buffer.clear();
+		SharedOStream out(&buffer);
+		context.reset();
+		for(int j = 0; j < numEvents; j++)
+		{
+			if(compact) EventUtils::serializeEventCompact(events[j], context, out);
+			else EventUtils::serializeEvent(events[j], out);
+		}
+	}
+	timer.stop();
+	double encodeTime = timer.getElapsedTimeInMilliSec();
+
+	Event evt;
+	timer.start();
+	for(int i = 0; i < iterations; i++)
+	{
+		SharedIStream in(&buffer[0], buffer.size());
+		context.reset();
+		for(int j = 0; j < numEvents; j++)
+		{
+			if(compact) EventUtils::deserializeEventCompact(evt, context, in);
+			else EventUtils::deserializeEvent(evt, in);
+		}
+	}
+	timer.stop();
+	double decodeTime = timer.getElapsedTimeInMilliSec();
+
+	double totalEvents = (double)numEvents * iterations;
+	printf("%-18s %8.1f %14.1f %14.1f\n", name, 
+		(double)buffer.size() / numEvents,
+		encodeTime * 1000000 / totalEvents,
+		decodeTime * 1000000 / totalEvents);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+	// Defaults: one frame worth of events from 20 tracked bodies at 180Hz, 
+	// with the application running at 60fps.
+	int numEvents = 60;
+	int numSources = 20;
+	int iterations = 10000;
+
+	for(int i = 1; i < argc; i++)
+	{
+		if(!strcmp(argv[i], "-n") && i + 1 < argc) numEvents = boost::lexical_cast<int>(argv[++i]);
+		else if(!strcmp(argv[i], "-s") && i + 1 < argc) numSources = boost::lexical_cast<int>(argv[++i]);
+		else if(!strcmp(argv[i], "-i") && i + 1 < argc) iterations = boost::lexical_cast<int>(argv[++i]);
+		else
+		{
+			printf("Usage: eventbench [-n events per frame] [-s sources] [-i iterations]\n");
+			return 0;
+		}
+	}
+	if(numEvents > EventSharingModule::MaxSharedEventsQueue) numEvents = EventSharingModule::MaxSharedEventsQueue;
+
+	Event events[EventSharingModule::MaxSharedEventsQueue];
+	for(int i = 0; i < numEvents; i++)
+	{
+		float t = i * 0.01f;
+		events[i].reset(Event::Update, Service::Mocap, i % numSources);
+		events[i].setPosition(Vector3f(sin(t), 1.5f + 0.1f * cos(t), -2.0f));
+		events[i].setOrientation(Quaternion(AngleAxis(t, Vector3f::UnitY())));
+	}
+
+	printf("%d events per frame, %d sources, %d iterations\n", numEvents, numSources, iterations);
+	printf("%-18s %8s %14s %14s\n", "ENCODING", "BYTES/EV", "ENCODE NS/EV", "DECODE NS/EV");
+	runBenchmark("full", events, numEvents, iterations, false, false);
+	runBenchmark("compact", events, numEvents, iterations, true, false);
+	runBenchmark("compact+quantized", events, numEvents, iterations, true, true);
+	return 0;
+}
@@ -44,7 +44,8 @@ using namespace omega;
 CameraOutput::CameraOutput(): 
 	myEnabled(false), myRenderTarget(NULL), myType(RenderTarget::RenderOffscreen),
 	myReadbackColorTarget(NULL), myReadbackDepthTarget(NULL),
-	myTextureColorTarget(NULL), myTextureDepthTarget(NULL)
+	myTextureColorTarget(NULL), myTextureDepthTarget(NULL),
+	myAsyncReadback(false)
 {
 	reset(RenderTarget::RenderOffscreen);
 }
@@ -56,6 +57,13 @@ void CameraOutput::reset(RenderTarget::Type type)
 	myRenderTarget = NULL;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void CameraOutput::setAsyncReadback(bool value)
+{
+	myAsyncReadback = value;
+	if(myRenderTarget != NULL) myRenderTarget->setAsyncReadback(value);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 void CameraOutput::setReadbackTarget(PixelData* color, PixelData* depth)
 {
@@ -102,6 +110,7 @@ void CameraOutput::beginDraw(const DrawContext& context)
 	if(myRenderTarget == NULL)
 	{
 		myRenderTarget = context.renderer->createRenderTarget(myType);
+		myRenderTarget->setAsyncReadback(myAsyncReadback);
 		if(myReadbackColorTarget != NULL) 
 		{
 			myRenderTarget->setReadbackTarget(myReadbackColorTarget, myReadbackDepthTarget, myReadbackViewport);
@@ -137,9 +146,29 @@ void CameraOutput::finishFrame(const FrameInfo& frame)
 {
 	if(myRenderTarget != NULL)
 	{
+		if(myReadbackTimeStat == NULL)
+		{
+			// Readback stats are shared by all camera outputs on the same context.
+			StatsManager* sm = SystemManager::instance()->getStatsManager();
+			uint id = frame.gpuContext->getId();
+			String timeStatName = ostr("ctx%1% readback", %id);
+			String latencyStatName = ostr("ctx%1% readback latency", %id);
+			myReadbackTimeStat = sm->findStat(timeStatName);
+			if(myReadbackTimeStat == NULL) myReadbackTimeStat = sm->createStat(timeStatName, StatsManager::Time);
+			myReadbackLatencyStat = sm->findStat(latencyStatName);
+			if(myReadbackLatencyStat == NULL) myReadbackLatencyStat = sm->createStat(latencyStatName, StatsManager::Time);
+		}
+
+		myReadbackTimeStat->startTiming();
 	    myRenderTarget->bind();
 		myRenderTarget->readback();
     	myRenderTarget->unbind();
+		myReadbackTimeStat->stopTiming();
+
+		if(myRenderTarget->isAsyncReadback())
+		{
+			myReadbackLatencyStat->addSample(myRenderTarget->getReadbackLatency());
+		}
 	}
 }
 
@@ -283,6 +283,12 @@ void ConsoleRenderPass::drawStats(Vector2f pos, Vector2f size, const DrawContext
 				pos + Vector2f(5, 0),
 				Vector2f(s->getCur(), 16),
 				Color(0.6f, 0.1f, 0.1f));
+			// Recent worst case (p99) time marker. The all-time max would
+			// stay stuck on startup spikes.
+			di->drawRect(
+				pos + Vector2f(5 + s->getPercentile(0.99f), 0),
+				Vector2f(2, 16),
+				Color(0.9f, 0.6f, 0.1f));
 
 			di->drawText(s->getName(), 
 				myFont, 
@@ -292,4 +298,48 @@ void ConsoleRenderPass::drawStats(Vector2f pos, Vector2f size, const DrawContext
 			pos += Vector2f(0, 20);
 		}
 	}
+
+	// Cluster time stats (master only): the bar spans the lowest to highest 
+	// node average, and the marker shows the worst node p99. Stats where one
+	// node is much slower than the others are labelled with the node name.
+	bool clusterHeader = false;
+	foreach(ClusterStat* cs, sm->getClusterStats())
+	{
+		if(cs->getType() == StatsManager::Time && cs->getNumNodes() > 1)
+		{
+			if(!clusterHeader)
+			{
+				pos += Vector2f(0, 10);
+				di->drawText("Cluster (min - max node avg)", myFont, 
+					pos + Vector2f(5, 0), Font::HALeft | Font::VAMiddle, Color::White);
+				pos += Vector2f(0, 20);
+				clusterHeader = true;
+			}
+			di->drawRect(
+				pos + Vector2f(5, 0),
+				Vector2f(cs->getMinAvg(), 16),
+				Color(0.1f, 0.3f, 0.6f));
+			di->drawRect(
+				pos + Vector2f(5 + cs->getMinAvg(), 0),
+				Vector2f(cs->getMaxAvg() - cs->getMinAvg(), 16),
+				Color(0.6f, 0.1f, 0.1f));
+			di->drawRect(
+				pos + Vector2f(5 + cs->getMaxP99(), 0),
+				Vector2f(2, 16),
+				Color(0.9f, 0.6f, 0.1f));
+
+			if(cs->hasOutlier())
+			{
+				di->drawText(ostr("%1% (%2%)", %cs->getName() %cs->getOutlierNode()), 
+					myFont, pos + Vector2f(5, 0), 
+					Font::HALeft | Font::VAMiddle, Color(1, 0.6f, 0.6f, 1));
+			}
+			else
+			{
+				di->drawText(cs->getName(), myFont, pos + Vector2f(5, 0), 
+					Font::HALeft | Font::VAMiddle, Color::White);
+			}
+			pos += Vector2f(0, 20);
+		}
+	}
 }
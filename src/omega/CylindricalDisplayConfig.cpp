@@ -158,7 +158,7 @@ std::pair<bool, Vector2f> CylindricalDisplayConfig::calculateScreenPosition(floa
     }
     if(y < MIN_Y)
     {
-        if(y > MAX_Y - MAX_Y_ERROR) y = MIN_Y;
+        if(y > MIN_Y - MAX_Y_ERROR) y = MIN_Y;
         else return Result(false, Vector2f::Zero());
     }
 
@@ -194,40 +194,50 @@ std::pair<bool, Vector2f> CylindricalDisplayConfig::calculateScreenPosition(floa
 ///////////////////////////////////////////////////////////////////////////////
 std::pair<bool, Vector2f> CylindricalDisplayConfig::getPointFromRay(const Ray& ray)
 {
-    typedef std::pair<bool, Vector2f> Result;
-
-    float ox = ray.getDirection().x();
-    float oy = ray.getDirection().x();
-    float oz = ray.getDirection().x();
-    float x0 = ray.getOrigin().x();
-    float y0 = ray.getOrigin().y();
-    float z0 = ray.getOrigin().z();
-    float r = myRadius;
+    std::pair<bool, Vector2f> res;
+    getPointsFromRays(&ray, 1, &res);
+    return res;
+}
 
-    // x coordinate of center of circle
-    float h = 0.0f;
-    // z coordinate of center of circle
-    float k = 0.0f;
+///////////////////////////////////////////////////////////////////////////////
+void CylindricalDisplayConfig::getPointsFromRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points)
+{
+    typedef std::pair<bool, Vector2f> Result;
 
-    float a = ox*ox + oz*oz;
-    float b = 2*ox*x0 + 2*oz*z0 - 2*h*ox - 2*k*oz;
-    float c = x0*x0 + z0*z0 + h*h + k*k - r*r - 2*h*x0 - 2*k*z0;
+    // The cylinder axis is the y axis: intersect the ray projections on the
+    // xz plane with a circle centered at the origin.
+    float r2 = myRadius * myRadius;
 
-    if(a != 0 && (b*b - 4*a*c) >= 0)
+    for(int i = 0; i < count; i++)
     {
-        float t1 = (-b + sqrt(b*b - 4*a*c)) / (2*a);
-        float t2 = (-b - sqrt(b*b - 4*a*c)) / (2*a);
-        float t = 0;
-        if(t1 >= 0) t = t1;
-        else if(t2 >= 0) t = t2;
-        else
+        const Vector3f& dir = rays[i].getDirection();
+        const Vector3f& orig = rays[i].getOrigin();
+        float ox = dir.x();
+        float oy = dir.y();
+        float oz = dir.z();
+        float x0 = orig.x();
+        float y0 = orig.y();
+        float z0 = orig.z();
+
+        float a = ox*ox + oz*oz;
+        float b = 2*ox*x0 + 2*oz*z0;
+        float c = x0*x0 + z0*z0 - r2;
+        float d = b*b - 4*a*c;
+
+        points[i] = Result(false, Vector2f::Zero());
+        if(a != 0 && d >= 0)
         {
-            return Result(false, Vector2f::Zero());
+            float sd = sqrt(d);
+            float t1 = (-b + sd) / (2*a);
+            float t2 = (-b - sd) / (2*a);
+            float t = (t1 >= 0) ? t1 : t2;
+            if(t >= 0)
+            {
+                float xpos = ox*t + x0;
+                float ypos = oy*t + y0;
+                float zpos = oz*t + z0;
+                points[i] = calculateScreenPosition(xpos, ypos, zpos);
+            }
         }
-        float xpos = ox*t + x0;
-        float ypos = oy*t + y0;
-        float zpos = oz*t + z0;
-        return calculateScreenPosition(xpos, ypos, zpos);
     }
-    return Result(false, Vector2f::Zero());
 }
@@ -97,6 +97,16 @@ void DisplayConfig::LoadConfig(Setting& scfg, DisplayConfig& cfg)
 	cfg.basePort = Config::getIntValue("basePort", scfg);
 
 	cfg.launcherInterval = Config::getIntValue("launcherInterval", scfg, 500);
+	cfg.launcherParallelism = Config::getIntValue("launcherParallelism", scfg, 8);
+	cfg.launcherTimeout = Config::getFloatValue("launcherTimeout", scfg, 30);
+
+	cfg.sharedMemoryTransport = Config::getBoolValue("sharedMemoryTransport", scfg, false);
+	cfg.sharedMemorySlots = Config::getIntValue("sharedMemorySlots", scfg, 4);
+	cfg.sharedMemorySlotSize = Config::getIntValue("sharedMemorySlotSize", scfg, 4096);
+	cfg.sharedMemoryTimeout = Config::getFloatValue("sharedMemoryTimeout", scfg, 10);
+
+	cfg.statsAggregationInterval = Config::getFloatValue("statsAggregationInterval", scfg, 1);
+	cfg.latencyInstrumentation = Config::getBoolValue("latencyInstrumentation", scfg, false);
 
 	const Setting& sTiles = scfg["tiles"];
 	// Reset number of nodes and tiles. Will count them in the next loop.
@@ -159,6 +169,10 @@ void DisplayConfig::LoadConfig(Setting& scfg, DisplayConfig& cfg)
 		cfg.configBuilder = new PlanarDisplayConfig();
 		cfg.configBuilder->buildConfig(cfg, scfg);
 	}
+
+	// Configuration builders may change tile offsets: build the tile lookup
+	// once they are done.
+	cfg.updateTileLookup();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -232,6 +246,142 @@ void DisplayConfig::setTilesEnabled(int tilex, int tiley, int tilew, int tileh,
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////////
+void DisplayConfig::updateTileLookup()
+{
+	// Collect tiles that process mouse events and the area they cover.
+	Vector<DisplayTileConfig*> lookupTiles;
+	Vector2i minPoint = Vector2i::Zero();
+	Vector2i maxPoint = Vector2i::Zero();
+	Vector2i minSize = Vector2i::Zero();
+	foreach(Tile t, tiles)
+	{
+		if(!t->disableMouse && t->pixelSize[0] > 0 && t->pixelSize[1] > 0)
+		{
+			Vector2i endPoint = t->offset + t->pixelSize;
+			if(lookupTiles.empty())
+			{
+				minPoint = t->offset;
+				maxPoint = endPoint;
+				minSize = t->pixelSize;
+			}
+			else
+			{
+				minPoint = minPoint.cwiseMin(t->offset);
+				maxPoint = maxPoint.cwiseMax(endPoint);
+				minSize = minSize.cwiseMin(t->pixelSize);
+			}
+			lookupTiles.push_back(t.getValue());
+		}
+	}
+
+	myLookupLock.lock();
+	myLookupCellStart.clear();
+	myLookupTiles.clear();
+	myLookupSize = Vector2i::Zero();
+
+	if(!lookupTiles.empty())
+	{
+		// Cells are as large as the smallest tile, but we grow them if
+		// needed to keep the number of cells bounded.
+		Vector2i extent = maxPoint - minPoint;
+		for(int i = 0; i < 2; i++)
+		{
+			int maxCellSize = (extent[i] + MaxLookupCells - 1) / MaxLookupCells;
+			myLookupCellSize[i] = max(max(minSize[i], maxCellSize), 1);
+			myLookupSize[i] = (extent[i] + myLookupCellSize[i] - 1) / myLookupCellSize[i];
+		}
+		myLookupOrigin = minPoint;
+
+		// Counting pass: find the number of tiles overlapping each cell,
+		// then turn counts into start indices.
+		int numCells = myLookupSize[0] * myLookupSize[1];
+		myLookupCellStart.resize(numCells + 1, 0);
+		for(int pass = 0; pass < 2; pass++)
+		{
+			Vector<int> cellFill;
+			if(pass == 1)
+			{
+				int total = 0;
+				for(int c = 0; c <= numCells; c++)
+				{
+					int count = myLookupCellStart[c];
+					myLookupCellStart[c] = total;
+					total += count;
+				}
+				myLookupTiles.resize(total, NULL);
+				cellFill.assign(myLookupCellStart.begin(), myLookupCellStart.end());
+			}
+
+			foreach(DisplayTileConfig* t, lookupTiles)
+			{
+				Vector2i first = t->offset - myLookupOrigin;
+				Vector2i last = first + t->pixelSize - Vector2i::Ones();
+				for(int y = first[1] / myLookupCellSize[1]; y <= last[1] / myLookupCellSize[1]; y++)
+				{
+					for(int x = first[0] / myLookupCellSize[0]; x <= last[0] / myLookupCellSize[0]; x++)
+					{
+						int c = y * myLookupSize[0] + x;
+						if(pass == 0) myLookupCellStart[c]++;
+						else myLookupTiles[cellFill[c]++] = t;
+					}
+				}
+			}
+		}
+	}
+	myLookupLock.unlock();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+DisplayTileConfig* DisplayConfig::findTile(const Vector2i& position) const
+{
+	myLookupLock.lock();
+	DisplayTileConfig* result = lookupTile(position);
+	myLookupLock.unlock();
+	return result;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+void DisplayConfig::findTiles(const Vector2i* positions, int count, DisplayTileConfig** result) const
+{
+	myLookupLock.lock();
+	for(int i = 0; i < count; i++) result[i] = lookupTile(positions[i]);
+	myLookupLock.unlock();
+}
+
+//////////////////////////////////////////////////////////////////////////////
+DisplayTileConfig* DisplayConfig::lookupTile(const Vector2i& position) const
+{
+	DisplayTileConfig* result = NULL;
+
+	Vector2i p = position - myLookupOrigin;
+	if(p[0] >= 0 && p[1] >= 0)
+	{
+		int x = p[0] / myLookupCellSize[0];
+		int y = p[1] / myLookupCellSize[1];
+		if(x < myLookupSize[0] && y < myLookupSize[1])
+		{
+			// Tiles are checked in the order they appear in the configuration,
+			// so overlapping tiles resolve the same way on every rebuild.
+			int c = y * myLookupSize[0] + x;
+			for(int i = myLookupCellStart[c]; i < myLookupCellStart[c + 1]; i++)
+			{
+				DisplayTileConfig* t = myLookupTiles[i];
+				if(position[0] >= t->offset[0] &&
+					position[1] >= t->offset[1] &&
+					position[0] < t->offset[0] + t->pixelSize[0] &&
+					position[1] < t->offset[1] + t->pixelSize[1])
+				{
+					result = t;
+					break;
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 void DisplayTileConfig::parseConfig(const Setting& sTile, DisplayConfig& cfg)
 {
@@ -43,47 +43,12 @@ using namespace omega;
 ///////////////////////////////////////////////////////////////////////////////
 Ray DisplayUtils::getViewRay(Vector2i position, const DisplayConfig& cfg)
 {
-    int channelWidth = cfg.tileResolution[0];
-    int channelHeight = cfg.tileResolution[1];
-    int displayWidth = cfg.canvasPixelSize[0];
-    int displayHeight = cfg.canvasPixelSize[1];
-
-    //if(position[0] < 0 || position[0] > displayWidth || 
-    //	position[1] < 0 || position[1] > displayHeight)
-    //{
-    //	ofwarn("EqualizerDisplaySystem::getViewRay: position out of bounds (%1%)", %position);
-    //	return Ray();
-    //}
-
-    int channelX = position[0] / channelWidth;
-    int channelY = position[1] / channelHeight;
-
-    int x = position[0] % channelWidth;
-    int y = position[1] % channelHeight;
-
-    DisplayTileConfig* dtc = cfg.tileGrid[channelX][channelY];
-    if(dtc != NULL && !dtc->disableMouse)
+    // Find the tile containing this pointer position. The lookup only 
+    // returns tiles with mouse processing active.
+    DisplayTileConfig* dtc = cfg.findTile(position);
+    if(dtc != NULL)
     {
-        // We found a tile in the grid that contains this mouse pointer event, and the tile mouse processing is active.
-        return getViewRay(Vector2i(x, y), dtc);
-    }
-
-    // No luck using the grid: go with the slower but generic method. Loop through the tiles until you find one that
-    // contains the pointer event.
-    typedef std::pair<String, DisplayTileConfig*> TileItem;
-    foreach(TileItem ti, cfg.tiles)
-    {
-        if(!ti.second->disableMouse)
-        {
-            if(position[0] > ti.second->offset[0] &&
-                position[1] > ti.second->offset[1] &&
-                position[0] < ti.second->offset[0] + ti.second->pixelSize[0] &&
-                position[1] < ti.second->offset[1] + ti.second->pixelSize[1])
-            {
-                Vector2i pos = position - ti.second->offset;
-                return getViewRay(pos, ti.second);
-            }
-        }
+        return getViewRay(position - dtc->offset, dtc);
     }
 
     // Suitable tile to process mouse pointer not found. return empty ray.
@@ -137,6 +102,69 @@ Ray DisplayUtils::getViewRay(Vector2i position, DisplayTileConfig* dtc)
     return Ray(p, direction);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void DisplayUtils::getViewRays(const Vector2i* positions, int count, Ray* rays, const DisplayConfig& cfg)
+{
+    if(count <= 0) return;
+
+    Vector<DisplayTileConfig*> dtcs;
+    dtcs.resize(count);
+    cfg.findTiles(positions, count, &dtcs[0]);
+
+    // Tile data transformed to world space. For a tile pixel (px, py) in 
+    // [0, 1] the ray origin is origin + up * py + right * px, and the ray 
+    // goes from the head position through it. Pointers are usually grouped
+    // on a few tiles, so we recompute this only when the tile changes.
+    DisplayTileConfig* cur = NULL;
+    bool valid = false;
+    Vector3f origin, up, right, head;
+    Vector2f invPixelSize;
+    for(int i = 0; i < count; i++)
+    {
+        DisplayTileConfig* dtc = dtcs[i];
+        if(dtc == NULL)
+        {
+            rays[i] = Ray();
+            continue;
+        }
+        if(dtc != cur)
+        {
+            cur = dtc;
+            Camera* camera = dtc->camera;
+            if(camera == NULL) camera = Engine::instance()->getDefaultCamera();
+            valid = (camera != NULL);
+            if(valid)
+            {
+                const Quaternion& orientation = camera->getOrientation();
+                const Vector3f& position = camera->getPosition();
+                origin = orientation * dtc->bottomLeft + position;
+                up = orientation * (dtc->topLeft - dtc->bottomLeft);
+                right = orientation * (dtc->bottomRight - dtc->bottomLeft);
+                head = orientation * camera->getHeadOffset() + position;
+                invPixelSize = Vector2f(1.0f / dtc->pixelSize[0], 1.0f / dtc->pixelSize[1]);
+            }
+            else
+            {
+                owarn("DisplayUtils::getViewRays: null camera, returning default rays.");
+            }
+        }
+        if(!valid)
+        {
+            rays[i] = Ray();
+            continue;
+        }
+
+        Vector2i pos = positions[i] - dtc->offset;
+        float px = pos[0] * invPixelSize[0];
+        float py = 1 - pos[1] * invPixelSize[1];
+
+        Vector3f p = origin + up * py + right * px;
+        Vector3f direction = p - head;
+        direction.normalize();
+        rays[i] = Ray(p, direction);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool DisplayUtils::getViewRayFromEvent(const Event& evt, Ray& ray, const DisplayConfig& cfg, bool normalizedPointerCoords, Camera* camera)
 {
@@ -193,7 +221,38 @@ std::pair<bool, Vector2f> DisplayUtils::getDisplayPointFromViewRay(const Ray& ra
             res.second[0] *= cfg.canvasPixelSize[0];
             res.second[1] *= cfg.canvasPixelSize[1];
         }
+        return res;
     }
 
     return Result(false, Vector2f::Zero());
 }
+
+///////////////////////////////////////////////////////////////////////////////
+int DisplayUtils::getDisplayPointsFromViewRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points, const DisplayConfig& cfg, bool normalizedPointerCoords)
+{
+    typedef std::pair<bool, Vector2f> Result;
+
+    if(cfg.rayToPointConverter == NULL)
+    {
+        for(int i = 0; i < count; i++) points[i] = Result(false, Vector2f::Zero());
+        return 0;
+    }
+
+    cfg.rayToPointConverter->getPointsFromRays(rays, count, points);
+
+    int hits = 0;
+    for(int i = 0; i < count; i++)
+    {
+        if(points[i].first)
+        {
+            // If needed, convert from normalized to pixel coordinates.
+            if(!normalizedPointerCoords)
+            {
+                points[i].second[0] *= cfg.canvasPixelSize[0];
+                points[i].second[1] *= cfg.canvasPixelSize[1];
+            }
+            hits++;
+        }
+    }
+    return hits;
+}
@@ -85,6 +85,7 @@ Engine::Engine(ApplicationBase* app):
     myDrawPointers(false),
     myPrimaryButton(Event::Button3),
     myEventDispatchEnabled(true),
+    myFirstUpdateDone(false),
     soundEnv(NULL)
 {
     mysInstance = this;
@@ -99,6 +100,7 @@ Engine::~Engine()
 ///////////////////////////////////////////////////////////////////////////////
 void Engine::initialize()
 {
+    myStartupTimer.start();
     myLock.lock();
     ImageUtils::internalInitialize();
 
@@ -291,6 +293,7 @@ void Engine::initialize()
     myUpdateTimeStat = sm->createStat("Engine update", StatsManager::Time);
     mySceneUpdateTimeStat = sm->createStat("Scene transform update", StatsManager::Time);
     myModuleUpdateTimeStat = sm->createStat("Modules update", StatsManager::Time);
+    myStartupTimeStat = sm->createStat("Engine startup", StatsManager::Time);
 
     myLock.unlock();
 }
@@ -498,6 +501,15 @@ void Engine::update(const UpdateContext& context)
     }
 
     myUpdateTimeStat->stopTiming();
+
+    if(!myFirstUpdateDone)
+    {
+        myFirstUpdateDone = true;
+        myStartupTimer.stop();
+        myStartupTimeStat->addSample(myStartupTimer.getElapsedTimeInMilliSec());
+        ofmsg("Engine: first frame updated %1% ms after initialization", 
+            %myStartupTimer.getElapsedTimeInMilliSec());
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
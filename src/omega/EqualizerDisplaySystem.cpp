@@ -43,6 +43,17 @@
 #include "omega/SystemManager.h"
 #include "omega/MouseService.h"
 
+#ifdef OMEGA_OS_WIN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#endif
+
 using namespace omega;
 using namespace co::base;
 using namespace std;
@@ -106,8 +117,9 @@ void EqualizerDisplaySystem::generateEqConfig()
 	END_BLOCK(result);
 	
 	START_BLOCK(result, "config");
-	// Latency > 0 makes everything explode when a local node is initialized, due to 
-	// multiple shared data messages sent to slave nodes before they initialize their local objects
+	// With latency > 0 the master updates frame N + 1 while slave nodes are
+	// still rendering frame N. Shared data is buffered in this case (see
+	// ConfigImpl::init), so slaves apply the shared data versions in frame order.
 	result += L(ostr("latency %1%", %eqcfg.latency));
 
 	for(int n = 0; n < eqcfg.numNodes; n++)
@@ -309,38 +321,254 @@ void EqualizerDisplaySystem::initialize(SystemManager* sys)
 	{
 		// Generate the equalizer configuration
 		generateEqConfig();
-		
-		for(int n = 0; n < myDisplayConfig.numNodes; n++)
-		{
-			DisplayNodeConfig& nc = myDisplayConfig.nodes[n];
 
-			if(nc.hostname != "local")
+		// Create the shared memory ring before launching nodes, so local
+		// nodes find it during initialization. One reader slot per node:
+		// only nodes running on this machine are allowed to attach.
+		if(myDisplayConfig.sharedMemoryTransport)
+		{
+			// The ring needs to buffer at least as many frames as the 
+			// master can run ahead of slaves.
+			int slots = max(myDisplayConfig.sharedMemorySlots, myDisplayConfig.latency + 2);
+			myRing = SharedMemoryRing::create(getSharedMemoryRingName(), 
+				slots, (size_t)myDisplayConfig.sharedMemorySlotSize * 1024,
+				myDisplayConfig.numNodes);
+			if(myRing != NULL)
 			{
-				// Launch the node if at least one of the tiles on the node is enabled.
-				bool enabled = false;
-				for(int i = 0; i < nc.numTiles; i++) enabled |= nc.tiles[i]->enabled;
-				
-				if(enabled)
+				for(int n = 0; n < myDisplayConfig.numNodes; n++)
 				{
-					String executable = StringUtils::replaceAll(myDisplayConfig.nodeLauncher, "%c", SystemManager::instance()->getApplication()->getExecutableName());
-					executable = StringUtils::replaceAll(executable, "%h", nc.hostname);
-				
-					// Substitute %d with current working directory
-					String cCurrentPath = ogetcwd();
-					executable = StringUtils::replaceAll(executable, "%d", cCurrentPath);
-				
-					// Setup the executable call. Note: we pass a-D argument to tell all
-					// instances what the main data directory is. We use ogetdataprefix
-					// because omain sets the data prefix to the root data dir during
-					// startup.
-					int port = myDisplayConfig.basePort + nc.port;
-					String cmd = ostr("%1% -c %2%@%3%:%4% -D %5%", %executable %SystemManager::instance()->getAppConfig()->getFilename() %nc.hostname %port %ogetdataprefix());
-					olaunch(cmd);
+					DisplayNodeConfig& nc = myDisplayConfig.nodes[n];
+					bool local = nc.hostname != "local" && isMasterHost(nc.hostname);
+					myRing->setReaderExpected(n, local);
 				}
+				ofmsg("EqualizerDisplaySystem: %1% nodes will use the shared memory transport",
+					%myRing->getNumExpectedReaders());
+			}
+		}
+
+		launchNodes();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+String EqualizerDisplaySystem::getNodeLaunchCommand(DisplayNodeConfig& nc)
+{
+	String executable = StringUtils::replaceAll(myDisplayConfig.nodeLauncher, "%c", SystemManager::instance()->getApplication()->getExecutableName());
+	executable = StringUtils::replaceAll(executable, "%h", nc.hostname);
+
+	// Substitute %d with current working directory
+	String cCurrentPath = ogetcwd();
+	executable = StringUtils::replaceAll(executable, "%d", cCurrentPath);
+
+	// Setup the executable call. Note: we pass a-D argument to tell all
+	// instances what the main data directory is. We use ogetdataprefix
+	// because omain sets the data prefix to the root data dir during
+	// startup.
+	int port = myDisplayConfig.basePort + nc.port;
+	return ostr("%1% -c %2%@%3%:%4% -D %5%", %executable %SystemManager::instance()->getAppConfig()->getFilename() %nc.hostname %port %ogetdataprefix());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns true if something is accepting connections on the specified host 
+// and port. A node is considered ready once its equalizer listener is up.
+static bool probeNode(const String& hostname, int port, int timeoutMs)
+{
+#ifdef OMEGA_OS_WIN
+	// Probes run before equalizer initializes the network, so make sure
+	// winsock is initialized. Calls are reference counted.
+	WSADATA wsaData;
+	if(WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) return false;
+#endif
+
+	addrinfo hints;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* addr = NULL;
+	String service = ostr("%1%", %port);
+	if(getaddrinfo(hostname.c_str(), service.c_str(), &hints, &addr) != 0)
+	{
+#ifdef OMEGA_OS_WIN
+		WSACleanup();
+#endif
+		return false;
+	}
+
+	bool ready = false;
+#ifdef OMEGA_OS_WIN
+	SOCKET s = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+	if(s != INVALID_SOCKET)
+	{
+		u_long nonBlocking = 1;
+		ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+	int s = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+	if(s >= 0)
+	{
+		fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+		// Non-blocking connect, so unreachable hosts do not stall the 
+		// launcher for the default connect timeout.
+		if(connect(s, addr->ai_addr, (int)addr->ai_addrlen) == 0) 
+		{
+			ready = true;
+		}
+		else
+		{
+			fd_set writeSet;
+			FD_ZERO(&writeSet);
+			FD_SET(s, &writeSet);
+			timeval tv;
+			tv.tv_sec = timeoutMs / 1000;
+			tv.tv_usec = (timeoutMs % 1000) * 1000;
+			if(select((int)s + 1, NULL, &writeSet, NULL, &tv) > 0)
+			{
+				int error = 0;
+				socklen_t len = sizeof(error);
+				getsockopt(s, SOL_SOCKET, SO_ERROR, (char*)&error, &len);
+				ready = (error == 0);
 			}
 		}
+#ifdef OMEGA_OS_WIN
+		closesocket(s);
+#else
+		close(s);
+#endif
+	}
+	freeaddrinfo(addr);
+#ifdef OMEGA_OS_WIN
+	WSACleanup();
+#endif
+	return ready;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void EqualizerDisplaySystem::launchNodes()
+{
+	// Collect the nodes we need to launch: a node is launched if at least 
+	// one of its tiles is enabled.
+	List<int> pending;
+	for(int n = 0; n < myDisplayConfig.numNodes; n++)
+	{
+		DisplayNodeConfig& nc = myDisplayConfig.nodes[n];
+		if(nc.hostname != "local")
+		{
+			bool enabled = false;
+			for(int i = 0; i < nc.numTiles; i++) enabled |= nc.tiles[i]->enabled;
+			if(enabled) pending.push_back(n);
+		}
+	}
+	if(pending.empty()) return;
+
+	// No readiness checks: launch everything and wait a fixed time.
+	if(myDisplayConfig.launcherTimeout <= 0)
+	{
+		foreach(int n, pending) olaunch(getNodeLaunchCommand(myDisplayConfig.nodes[n]));
 		osleep(myDisplayConfig.launcherInterval);
+		return;
+	}
+
+	StatsManager* sm = SystemManager::instance()->getStatsManager();
+	myLaunchStat = sm->createStat("Cluster launch", StatsManager::Time);
+
+	int numNodes = (int)pending.size();
+	int parallelism = myDisplayConfig.launcherParallelism;
+	if(parallelism <= 0) parallelism = numNodes;
+	ofmsg("EqualizerDisplaySystem: launching %1% nodes (max %2% at a time)", 
+		%numNodes %parallelism);
+
+	// Nodes launched and not ready yet, with their launch times.
+	List< std::pair<int, double> > launching;
+	int numReady = 0;
+	Timer timer;
+	timer.start();
+	while(!pending.empty() || !launching.empty())
+	{
+		while(!pending.empty() && (int)launching.size() < parallelism)
+		{
+			int n = pending.front();
+			pending.pop_front();
+			olaunch(getNodeLaunchCommand(myDisplayConfig.nodes[n]));
+			launching.push_back(std::make_pair(n, timer.getElapsedTimeInSec()));
+		}
+
+		List< std::pair<int, double> >::iterator it = launching.begin();
+		while(it != launching.end())
+		{
+			DisplayNodeConfig& nc = myDisplayConfig.nodes[it->first];
+			int port = myDisplayConfig.basePort + nc.port;
+			double elapsed = timer.getElapsedTimeInSec() - it->second;
+			if(probeNode(nc.hostname, port, 10))
+			{
+				String nodeName = ostr("%1%:%2%", %nc.hostname %port);
+				Ref<Stat> s = sm->createStat(ostr("Node %1% ready", %nodeName), StatsManager::Time);
+				s->addSample(elapsed * 1000);
+				myNodeReadyStats.push_back(s);
+				ofmsg("EqualizerDisplaySystem: node %1% ready in %2% ms", 
+					%nodeName %(int)(elapsed * 1000));
+				numReady++;
+				it = launching.erase(it);
+			}
+			else if(elapsed > myDisplayConfig.launcherTimeout)
+			{
+				// Give up waiting: equalizer will report the node as 
+				// failed if it never comes up.
+				ofwarn("EqualizerDisplaySystem: node %1%:%2% not ready after %3% s", 
+					%nc.hostname %port %myDisplayConfig.launcherTimeout);
+				it = launching.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+		if(!launching.empty()) osleep(10);
+	}
+	timer.stop();
+	myLaunchStat->addSample(timer.getElapsedTimeInMilliSec());
+	ofmsg("EqualizerDisplaySystem: %1%/%2% nodes ready in %3% ms", 
+		%numReady %numNodes %(int)timer.getElapsedTimeInMilliSec());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+String EqualizerDisplaySystem::getSharedMemoryRingName()
+{
+	// basePort is different for each application instance.
+	return ostr("omegalib-eq-%1%", %myDisplayConfig.basePort);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool EqualizerDisplaySystem::isMasterHost(const String& hostname)
+{
+	if(hostname == "localhost" || hostname == "127.0.0.1") return true;
+#ifndef OMEGA_OS_WIN
+	char localHostname[256];
+	if(gethostname(localHostname, 256) == 0 && hostname == localHostname) return true;
+#endif
+	return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+SharedMemoryRing* EqualizerDisplaySystem::openSharedMemoryRing(uint64 sessionToken)
+{
+	if(!myDisplayConfig.sharedMemoryTransport) return NULL;
+
+	// Find the index of this node: slave instances are launched with a
+	// hostname:port string identifying their node.
+	const String& hostAndPort = SystemManager::instance()->getHostnameAndPort();
+	for(int n = 0; n < myDisplayConfig.numNodes; n++)
+	{
+		DisplayNodeConfig& nc = myDisplayConfig.nodes[n];
+		String nodeHostAndPort = ostr("%1%:%2%", %nc.hostname %(myDisplayConfig.basePort + nc.port));
+		if(nodeHostAndPort == hostAndPort)
+		{
+			// The master creates the ring before launching nodes, so we don't
+			// need to wait here: if the ring is not there, the master is 
+			// running on a different machine.
+			return SharedMemoryRing::open(getSharedMemoryRingName(), n, 0, sessionToken);
+		}
 	}
+	return NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -469,6 +697,7 @@ void EqualizerDisplaySystem::cleanup()
 
 	delete myNodeFactory;
 	SharedDataServices::cleanup();
+	myRing = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
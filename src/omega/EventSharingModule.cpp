@@ -25,7 +25,8 @@
  * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *************************************************************************************************/
 #include "omega/EventSharingModule.h"
-#include "eqinternal/eqinternal.h"
+#include "omega/SystemManager.h"
+#include "omega/Engine.h"
 
 using namespace omega;
 
@@ -38,6 +39,10 @@ EventSharingModule::EventSharingModule():
 {
 	mysInstance = this;
 	enableSharedData();
+
+	Config* syscfg = SystemManager::instance()->getSystemConfig();
+	myCompactEncoding = syscfg->getBoolValue("config/compactEventEncoding", true);
+	myEncodeContext.quantizeOrientation = syscfg->getBoolValue("config/quantizeEventOrientation", false);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -83,11 +88,14 @@ void EventSharingModule::share(const Event& evt)
 void EventSharingModule::commitSharedData(SharedOStream& out)
 {
 	myQueueLock.lock();
-	out << myQueuedEvents;
+	int encoding = myCompactEncoding ? EventUtils::EncodingCompact : EventUtils::EncodingFull;
+	out << (myQueuedEvents | (encoding << EncodingShift));
+	myEncodeContext.reset();
 	int i = 0;
 	while(myQueuedEvents)
 	{
-		EventUtils::serializeEvent(myEventQueue[i++], *out.getInternalStream());
+		if(myCompactEncoding) EventUtils::serializeEventCompact(myEventQueue[i++], myEncodeContext, out);
+		else EventUtils::serializeEvent(myEventQueue[i++], out);
 		myQueuedEvents--;
 	}
 	myQueueLock.unlock();
@@ -98,7 +106,11 @@ void EventSharingModule::updateSharedData(SharedIStream& in)
 {
 	// Read the events from the network data stream, and send them to the engine for processing.
 	myQueueLock.lock();
-	in >> myQueuedEvents;
+	int header;
+	in >> header;
+	myQueuedEvents = header & ((1 << EncodingShift) - 1);
+	bool compact = (header >> EncodingShift) == EventUtils::EncodingCompact;
+	myDecodeContext.reset();
 	if(myQueuedEvents != 0)
 	{
 		Engine* server = getEngine();
@@ -108,7 +120,8 @@ void EventSharingModule::updateSharedData(SharedIStream& in)
 		{
 			Event evt;
 			//Event* evtHead = sm->writeHead();
-			EventUtils::deserializeEvent(evt, *in.getInternalStream());
+			if(compact) EventUtils::deserializeEventCompact(evt, myDecodeContext, in);
+			else EventUtils::deserializeEvent(evt, in);
 
 			if(evt.isProcessed())
 			{
@@ -0,0 +1,393 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	Conversion of omegalib events to and from the stream format used to share
+ *  data between nodes.
+ ******************************************************************************/
+#include "omega/EventUtils.h"
+
+#include <math.h>
+
+using namespace omega;
+
+namespace
+{
+	// Field presence mask bits used by the compact encoding.
+	enum CompactField
+	{
+		FieldSource = 1 << 0,
+		FieldService = 1 << 1,
+		FieldType = 1 << 2,
+		FieldFlags = 1 << 3,
+		FieldPosition = 1 << 4,
+		FieldOrientation = 1 << 5,
+		FieldQuantizedOrientation = 1 << 6,
+		FieldExtraData = 1 << 7
+	};
+
+	// Max size of the fixed part of a compact event: mask, up to 9 varints, 
+	// position and orientation.
+	const int MaxCompactEventSize = 1 + 9 * 10 + 3 * 4 + 4 * 4;
+
+	// Quantized orientations store the three smallest components: these are 
+	// always within +-1/sqrt(2).
+	const float OrientationScale = 32767.0f * 1.41421356f;
+
+	///////////////////////////////////////////////////////////////////////////
+	// Writes a zigzag-encoded variable length integer: small positive and
+	// negative values take a single byte.
+	inline uint8_t* writeVarint(uint8_t* p, int64_t value)
+	{
+		uint64_t v = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+		while(v >= 0x80)
+		{
+			*p++ = (uint8_t)(v | 0x80);
+			v >>= 7;
+		}
+		*p++ = (uint8_t)v;
+		return p;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	inline int64_t readVarint(SharedIStream& is)
+	{
+		uint64_t v = 0;
+		int shift = 0;
+		uint8_t b;
+		do
+		{
+			is >> b;
+			v |= (uint64_t)(b & 0x7f) << shift;
+			shift += 7;
+		} while((b & 0x80) && shift < 64);
+		return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// Event fields have different integer and enum types: convert through 
+	// int64 in both directions.
+	template<typename T> inline void assignField(T& field, int64_t value)
+	{ field = (T)value; }
+
+	///////////////////////////////////////////////////////////////////////////
+	// Rebuilds the largest component of a quantized orientation.
+	inline void completeOrientation(float* q, int largest)
+	{
+		float sumSq = 0;
+		for(int i = 0; i < 4; i++) if(i != largest) sumSq += q[i] * q[i];
+		q[largest] = sumSq < 1 ? sqrtf(1 - sumSq) : 0;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	// Writes q as an index byte plus its three smallest components (7 bytes).
+	// q is replaced with its quantized value, so the encoder can track what
+	// decoders will see.
+	uint8_t* writeQuantizedOrientation(uint8_t* p, float* q)
+	{
+		int largest = 0;
+		for(int i = 1; i < 4; i++) if(fabsf(q[i]) > fabsf(q[largest])) largest = i;
+		// q and -q are the same rotation: flip the quaternion so the largest
+		// component is positive and does not need a sign.
+		float sign = q[largest] < 0 ? -1.0f : 1.0f;
+		*p++ = (uint8_t)largest;
+		for(int i = 0; i < 4; i++)
+		{
+			if(i != largest)
+			{
+				float c = floorf(q[i] * sign * OrientationScale + 0.5f);
+				if(c > 32767) c = 32767;
+				if(c < -32767) c = -32767;
+				int16_t qc = (int16_t)c;
+				memcpy(p, &qc, sizeof(int16_t));
+				p += sizeof(int16_t);
+				q[i] = qc / OrientationScale;
+			}
+		}
+		completeOrientation(q, largest);
+		return p;
+	}
+
+	///////////////////////////////////////////////////////////////////////////
+	void readQuantizedOrientation(SharedIStream& is, float* q)
+	{
+		uint8_t largest;
+		is >> largest;
+		largest &= 3;
+		for(int i = 0; i < 4; i++)
+		{
+			if(i != largest)
+			{
+				int16_t qc;
+				is >> qc;
+				q[i] = qc / OrientationScale;
+			}
+		}
+		completeOrientation(q, largest);
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void EventUtils::CompactContext::reset()
+{
+	timestamp = 0;
+	sourceId = 0;
+	serviceId = 0;
+	serviceType = 0;
+	type = 0;
+	flags = 0;
+	sources.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+EventUtils::CompactContext::SourceState& EventUtils::CompactContext::getSource(int64_t serviceId, int64_t sourceId)
+{
+	// Batches contain few sources: a linear search is faster than a map.
+	for(size_t i = 0; i < sources.size(); i++)
+	{
+		if(sources[i].serviceId == serviceId && sources[i].sourceId == sourceId) return sources[i];
+	}
+	SourceState s;
+	s.serviceId = serviceId;
+	s.sourceId = sourceId;
+	s.position[0] = s.position[1] = s.position[2] = 0;
+	s.orientation[0] = s.orientation[1] = s.orientation[2] = 0;
+	s.orientation[3] = 1;
+	sources.push_back(s);
+	return sources.back();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void EventUtils::serializeEvent(Event& evt, SharedOStream& os)
+{
+    os << evt.myTimestamp;
+    os << evt.mySourceId;
+    os << evt.myServiceId;
+    os << evt.myServiceType;
+    os << evt.myType;
+    os << evt.myFlags;
+    os << evt.myPosition[0] << evt.myPosition[1] << evt.myPosition[2];
+    os << evt.myOrientation.x() << evt.myOrientation.y() << evt.myOrientation.z() << evt.myOrientation.w();
+
+    // Serialize extra data
+    os << evt.myExtraDataType;
+    os << evt.myExtraDataItems;
+    if(evt.myExtraDataType != Event::ExtraDataNull)
+    {
+        os << evt.myExtraDataValidMask;
+        os.write(evt.myExtraData, evt.getExtraDataSize());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void EventUtils::deserializeEvent(Event& evt, SharedIStream& is)
+{
+    is >> evt.myTimestamp;
+    is >> evt.mySourceId;
+    is >> evt.myServiceId;
+    is >> evt.myServiceType;
+    is >> evt.myType;
+    is >> evt.myFlags;
+    is >> evt.myPosition[0] >> evt.myPosition[1] >> evt.myPosition[2];
+    is >> evt.myOrientation.x() >> evt.myOrientation.y() >> evt.myOrientation.z() >> evt.myOrientation.w();
+
+    // Deserialize extra data
+    is >> evt.myExtraDataType;
+    is >> evt.myExtraDataItems;
+    if(evt.myExtraDataType != Event::ExtraDataNull)
+    {
+        is >> evt.myExtraDataValidMask;
+        is.read(evt.myExtraData, evt.getExtraDataSize());
+    }
+    if(evt.myExtraDataType == Event::ExtraDataString)
+    {
+        evt.myExtraData[evt.getExtraDataSize()] = '\0';
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void EventUtils::serializeEventCompact(Event& evt, CompactContext& ctx, SharedOStream& os)
+{
+	// Encode the fixed part of the event in a local buffer, so it gets 
+	// written to the stream with a single call. The mask goes in front.
+	uint8_t buffer[MaxCompactEventSize];
+	uint8_t* p = buffer + 1;
+	uint8_t mask = 0;
+
+	// The timestamp is always written, as a difference from the previous
+	// event timestamp.
+	int64_t timestamp = (int64_t)evt.myTimestamp;
+	p = writeVarint(p, timestamp - ctx.timestamp);
+	ctx.timestamp = timestamp;
+
+	// Other header fields are only written when they change.
+	int64_t sourceId = (int64_t)evt.mySourceId;
+	if(sourceId != ctx.sourceId)
+	{
+		mask |= FieldSource;
+		p = writeVarint(p, sourceId);
+		ctx.sourceId = sourceId;
+	}
+	int64_t serviceId = (int64_t)evt.myServiceId;
+	int64_t serviceType = (int64_t)evt.myServiceType;
+	if(serviceId != ctx.serviceId || serviceType != ctx.serviceType)
+	{
+		mask |= FieldService;
+		p = writeVarint(p, serviceId);
+		p = writeVarint(p, serviceType);
+		ctx.serviceId = serviceId;
+		ctx.serviceType = serviceType;
+	}
+	int64_t type = (int64_t)evt.myType;
+	if(type != ctx.type)
+	{
+		mask |= FieldType;
+		p = writeVarint(p, type);
+		ctx.type = type;
+	}
+	int64_t flags = (int64_t)evt.myFlags;
+	if(flags != ctx.flags)
+	{
+		mask |= FieldFlags;
+		p = writeVarint(p, flags);
+		ctx.flags = flags;
+	}
+
+	// Position and orientation are only written when they differ from the 
+	// previous event of the same source.
+	CompactContext::SourceState& src = ctx.getSource(serviceId, sourceId);
+	float position[3] = { evt.myPosition[0], evt.myPosition[1], evt.myPosition[2] };
+	if(memcmp(position, src.position, sizeof(position)) != 0)
+	{
+		mask |= FieldPosition;
+		memcpy(p, position, sizeof(position));
+		p += sizeof(position);
+		memcpy(src.position, position, sizeof(position));
+	}
+	float orientation[4] = { 
+		evt.myOrientation.x(), evt.myOrientation.y(), 
+		evt.myOrientation.z(), evt.myOrientation.w() };
+	if(memcmp(orientation, src.orientation, sizeof(orientation)) != 0)
+	{
+		mask |= FieldOrientation;
+		// Remember the unquantized value: quantization modifies orientation,
+		// and comparing the next event against the quantized value would
+		// never match.
+		memcpy(src.orientation, orientation, sizeof(orientation));
+		if(ctx.quantizeOrientation)
+		{
+			mask |= FieldQuantizedOrientation;
+			p = writeQuantizedOrientation(p, orientation);
+		}
+		else
+		{
+			memcpy(p, orientation, sizeof(orientation));
+			p += sizeof(orientation);
+		}
+	}
+
+	if(evt.myExtraDataType != Event::ExtraDataNull)
+	{
+		mask |= FieldExtraData;
+		p = writeVarint(p, (int64_t)evt.myExtraDataType);
+		p = writeVarint(p, (int64_t)evt.myExtraDataItems);
+		p = writeVarint(p, (int64_t)evt.myExtraDataValidMask);
+	}
+
+	buffer[0] = mask;
+	os.write(buffer, p - buffer);
+	if(mask & FieldExtraData)
+	{
+		os.write(evt.myExtraData, evt.getExtraDataSize());
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void EventUtils::deserializeEventCompact(Event& evt, CompactContext& ctx, SharedIStream& is)
+{
+	uint8_t mask;
+	is >> mask;
+
+	ctx.timestamp += readVarint(is);
+	if(mask & FieldSource) ctx.sourceId = readVarint(is);
+	if(mask & FieldService)
+	{
+		ctx.serviceId = readVarint(is);
+		ctx.serviceType = readVarint(is);
+	}
+	if(mask & FieldType) ctx.type = readVarint(is);
+	if(mask & FieldFlags) ctx.flags = readVarint(is);
+
+	assignField(evt.myTimestamp, ctx.timestamp);
+	assignField(evt.mySourceId, ctx.sourceId);
+	assignField(evt.myServiceId, ctx.serviceId);
+	assignField(evt.myServiceType, ctx.serviceType);
+	assignField(evt.myType, ctx.type);
+	assignField(evt.myFlags, ctx.flags);
+
+	CompactContext::SourceState& src = ctx.getSource(ctx.serviceId, ctx.sourceId);
+	if(mask & FieldPosition)
+	{
+		is.read(src.position, sizeof(src.position));
+	}
+	if(mask & FieldQuantizedOrientation)
+	{
+		readQuantizedOrientation(is, src.orientation);
+	}
+	else if(mask & FieldOrientation)
+	{
+		is.read(src.orientation, sizeof(src.orientation));
+	}
+	evt.myPosition[0] = src.position[0];
+	evt.myPosition[1] = src.position[1];
+	evt.myPosition[2] = src.position[2];
+	evt.myOrientation.x() = src.orientation[0];
+	evt.myOrientation.y() = src.orientation[1];
+	evt.myOrientation.z() = src.orientation[2];
+	evt.myOrientation.w() = src.orientation[3];
+
+	if(mask & FieldExtraData)
+	{
+		assignField(evt.myExtraDataType, readVarint(is));
+		assignField(evt.myExtraDataItems, readVarint(is));
+		assignField(evt.myExtraDataValidMask, readVarint(is));
+		is.read(evt.myExtraData, evt.getExtraDataSize());
+		if(evt.myExtraDataType == Event::ExtraDataString)
+		{
+			evt.myExtraData[evt.getExtraDataSize()] = '\0';
+		}
+	}
+	else
+	{
+		evt.myExtraDataType = Event::ExtraDataNull;
+		evt.myExtraDataItems = 0;
+	}
+}
@@ -0,0 +1,291 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	Timestamps collected along the cluster frame pipeline, used to measure 
+ *  end-to-end frame latency on each node.
+ ******************************************************************************/
+#include "omega/FrameTimeline.h"
+#include "omega/SharedMemoryRing.h"
+#include "omega/SystemManager.h"
+
+using namespace omega;
+
+Ref<FrameTimeline> FrameTimeline::mysInstance;
+
+///////////////////////////////////////////////////////////////////////////////
+FrameTimeline* FrameTimeline::instance()
+{
+	if(mysInstance == NULL) mysInstance = new FrameTimeline();
+	return mysInstance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+double FrameTimeline::getTime()
+{
+	// Same clock used to timestamp shared memory frames.
+	return SharedMemoryRing::getTime();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+FrameTimeline::FrameTimeline()
+{
+	memset(myPending, 0, sizeof(myPending));
+	memset(myMasterFrames, 0, sizeof(myMasterFrames));
+	for(int i = 0; i < MaxPendingFrames; i++) myPendingValid[i] = false;
+	// Mark master frame slots as empty.
+	for(int i = 0; i < MaxMasterFrames; i++) myMasterFrames[i].frame = (uint64)-1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::beginFrame(uint64 frame)
+{
+	double t = getTime();
+	myLock.lock();
+	int slot = frame % MaxPendingFrames;
+	memset(&myPending[slot], 0, sizeof(FrameTiming));
+	myPending[slot].frame = frame;
+	myPending[slot].applyTime = t;
+	myPendingValid[slot] = true;
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+FrameTiming* FrameTimeline::findPending(uint64 frame)
+{
+	int slot = frame % MaxPendingFrames;
+	if(myPendingValid[slot] && myPending[slot].frame == frame) return &myPending[slot];
+	return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::markDrawStart(uint64 frame)
+{
+	double t = getTime();
+	myLock.lock();
+	FrameTiming* ft = findPending(frame);
+	if(ft != NULL && (ft->drawStart == 0 || t < ft->drawStart)) ft->drawStart = t;
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::markDrawEnd(uint64 frame)
+{
+	double t = getTime();
+	myLock.lock();
+	FrameTiming* ft = findPending(frame);
+	if(ft != NULL && t > ft->drawEnd) ft->drawEnd = t;
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::markSwap(uint64 frame)
+{
+	double t = getTime();
+	myLock.lock();
+	FrameTiming* ft = findPending(frame);
+	if(ft != NULL && t > ft->swapTime) ft->swapTime = t;
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool FrameTimeline::popFrame(uint64 before, FrameTiming& timing)
+{
+	myLock.lock();
+	int oldest = -1;
+	for(int i = 0; i < MaxPendingFrames; i++)
+	{
+		if(myPendingValid[i] && myPending[i].frame < before &&
+			(oldest == -1 || myPending[i].frame < myPending[oldest].frame))
+		{
+			oldest = i;
+		}
+	}
+	if(oldest != -1)
+	{
+		timing = myPending[oldest];
+		myPendingValid[oldest] = false;
+	}
+	myLock.unlock();
+	return oldest != -1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::addMasterFrame(uint64 frame, double pollTime, double commitTime)
+{
+	myLock.lock();
+	FrameTiming& mf = myMasterFrames[frame % MaxMasterFrames];
+	memset(&mf, 0, sizeof(FrameTiming));
+	mf.frame = frame;
+	mf.pollTime = pollTime;
+	mf.commitTime = commitTime;
+
+	if(myCommitStat == NULL)
+	{
+		StatsManager* sm = SystemManager::instance()->getStatsManager();
+		myCommitStat = sm->createStat("Latency commit", StatsManager::Time);
+	}
+	myCommitStat->addSample((commitTime - pollTime) * 1000);
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+FrameTimeline::NodeInfo& FrameTimeline::getNode(const String& node)
+{
+	Dictionary<String, NodeInfo>::iterator it = myNodes.find(node);
+	if(it != myNodes.end()) return it->second;
+
+	NodeInfo& info = myNodes[node];
+	info.clockOffset = 0;
+	info.bestRoundTrip = 1e9;
+	StatsManager* sm = SystemManager::instance()->getStatsManager();
+	info.transferStat = sm->createStat(ostr("Latency %1% transfer", %node), StatsManager::Time);
+	info.drawWaitStat = sm->createStat(ostr("Latency %1% draw wait", %node), StatsManager::Time);
+	info.drawStat = sm->createStat(ostr("Latency %1% draw", %node), StatsManager::Time);
+	info.swapStat = sm->createStat(ostr("Latency %1% swap", %node), StatsManager::Time);
+	info.totalStat = sm->createStat(ostr("Latency %1% total", %node), StatsManager::Time);
+	return info;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::addNodeFrame(const String& node, const FrameTiming& timing, double sendTime, double receiveTime)
+{
+	myLock.lock();
+	const FrameTiming& mf = myMasterFrames[timing.frame % MaxMasterFrames];
+	if(mf.frame == timing.frame)
+	{
+		NodeInfo& info = getNode(node);
+
+		// Commit / apply is the master -> node leg, send / receive is the 
+		// node -> master leg. Samples with the shortest round trip give the 
+		// most accurate offset. The best round trip slowly ages, so the 
+		// estimate keeps following clock drift.
+		double roundTrip = (receiveTime - mf.commitTime) - (sendTime - timing.applyTime);
+		if(roundTrip < info.bestRoundTrip)
+		{
+			info.bestRoundTrip = roundTrip;
+			info.clockOffset = ((timing.applyTime - mf.commitTime) + (sendTime - receiveTime)) / 2;
+		}
+		info.bestRoundTrip *= 1.01;
+
+		// Convert node timestamps to the master clock.
+		FrameTiming ft = timing;
+		ft.applyTime -= info.clockOffset;
+		if(ft.drawStart != 0) ft.drawStart -= info.clockOffset;
+		if(ft.drawEnd != 0) ft.drawEnd -= info.clockOffset;
+		if(ft.swapTime != 0) ft.swapTime -= info.clockOffset;
+		addFrame(node, info, ft);
+	}
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::addLocalFrame(const String& node, const FrameTiming& timing)
+{
+	myLock.lock();
+	const FrameTiming& mf = myMasterFrames[timing.frame % MaxMasterFrames];
+	if(mf.frame == timing.frame)
+	{
+		addFrame(node, getNode(node), timing);
+	}
+	myLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FrameTimeline::addFrame(const String& node, NodeInfo& info, FrameTiming timing)
+{
+	const FrameTiming& mf = myMasterFrames[timing.frame % MaxMasterFrames];
+	timing.pollTime = mf.pollTime;
+	timing.commitTime = mf.commitTime;
+
+	info.transferStat->addSample((timing.applyTime - timing.commitTime) * 1000);
+	// Nodes with no enabled tiles do not draw.
+	if(timing.drawStart != 0)
+	{
+		info.drawWaitStat->addSample((timing.drawStart - timing.applyTime) * 1000);
+		info.drawStat->addSample((timing.drawEnd - timing.drawStart) * 1000);
+		if(timing.swapTime != 0)
+		{
+			info.swapStat->addSample((timing.swapTime - timing.drawEnd) * 1000);
+			info.totalStat->addSample((timing.swapTime - timing.pollTime) * 1000);
+		}
+	}
+
+	Record r;
+	r.node = node;
+	r.timing = timing;
+	myHistory.push_back(r);
+	if(myHistory.size() > MaxHistory) myHistory.pop_front();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+double FrameTimeline::getClockOffset(const String& node)
+{
+	myLock.lock();
+	Dictionary<String, NodeInfo>::iterator it = myNodes.find(node);
+	double offset = it != myNodes.end() ? it->second.clockOffset : 0;
+	myLock.unlock();
+	return offset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool FrameTimeline::dumpTimeline(const String& filename)
+{
+	FILE* f = fopen(filename.c_str(), "w");
+	if(f == NULL)
+	{
+		ofwarn("FrameTimeline::dumpTimeline: could not open %1%", %filename);
+		return false;
+	}
+
+	myLock.lock();
+	fprintf(f, "node,frame,poll,commit,apply,drawStart,drawEnd,swap,clockOffset\n");
+	// Times are relative to the first polled frame in the history. Stages 
+	// that did not happen on a node are left empty.
+	double base = myHistory.empty() ? 0 : myHistory.front().timing.pollTime;
+	foreach(Record r, myHistory)
+	{
+		const FrameTiming& t = r.timing;
+		fprintf(f, "%s,%llu,%.3f,%.3f,%.3f,", r.node.c_str(), (unsigned long long)t.frame, 
+			(t.pollTime - base) * 1000, (t.commitTime - base) * 1000, (t.applyTime - base) * 1000);
+		if(t.drawStart != 0) fprintf(f, "%.3f,%.3f,", (t.drawStart - base) * 1000, (t.drawEnd - base) * 1000);
+		else fprintf(f, ",,");
+		if(t.swapTime != 0) fprintf(f, "%.3f,", (t.swapTime - base) * 1000);
+		else fprintf(f, ",");
+		fprintf(f, "%.3f\n", myNodes[r.node].clockOffset * 1000);
+	}
+	int numFrames = (int)myHistory.size();
+	myLock.unlock();
+
+	fclose(f);
+	ofmsg("FrameTimeline: %1% frames written to %2%", %numFrames %filename);
+	return true;
+}
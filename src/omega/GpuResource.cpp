@@ -25,14 +25,166 @@
  * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *************************************************************************************************/
 #include "omega/GpuResource.h"
+#include "omega/glheaders.h"
+
 using namespace omega;
 
 uint GpuContext::mysNumContexts = 0;
 Lock GpuContext::mysContextLock = Lock();
 
-GpuContext::GpuContext()
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GpuContext::GpuContext():
+	myFrameNum(0),
+	myFirstResource(NULL),
+	myGpuMemoryUsage(0)
 {
 	mysContextLock.lock();
 	myId = mysNumContexts++;
 	mysContextLock.unlock();
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GpuContext::addResource(GpuResource* res)
+{
+	myResourceLock.lock();
+	res->myPrevResource = NULL;
+	res->myNextResource = myFirstResource;
+	if(myFirstResource != NULL) myFirstResource->myPrevResource = res;
+	myFirstResource = res;
+	res->myRegistered = true;
+	myResourceLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GpuContext::removeResource(GpuResource* res)
+{
+	myResourceLock.lock();
+	if(res->myRegistered)
+	{
+		if(res->myPrevResource != NULL) res->myPrevResource->myNextResource = res->myNextResource;
+		else myFirstResource = res->myNextResource;
+		if(res->myNextResource != NULL) res->myNextResource->myPrevResource = res->myPrevResource;
+		res->myPrevResource = NULL;
+		res->myNextResource = NULL;
+		res->myRegistered = false;
+	}
+	myResourceLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GpuContext::queueRelease(ObjectType type, GLuint id, size_t size)
+{
+	if(id == 0 && size == 0) return;
+	ReleaseRequest req;
+	req.type = type;
+	req.id = id;
+	req.size = size;
+
+	myResourceLock.lock();
+	myReleaseQueue.push_back(req);
+	myResourceLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GpuContext::releaseObjects()
+{
+	// Swap the queue out so we do not keep the lock while deleting objects.
+	Vector<ReleaseRequest> queue;
+	myResourceLock.lock();
+	if(myReleaseQueue.empty())
+	{
+		myResourceLock.unlock();
+		return;
+	}
+	queue.swap(myReleaseQueue);
+	myResourceLock.unlock();
+
+	foreach(const ReleaseRequest& req, queue)
+	{
+		// Requests with a null id are only used for memory accounting.
+		if(req.id != 0)
+		{
+			switch(req.type)
+			{
+			case ObjectTexture: glDeleteTextures(1, &req.id); break;
+			case ObjectBuffer: glDeleteBuffers(1, &req.id); break;
+			case ObjectFramebuffer: glDeleteFramebuffers(1, &req.id); break;
+			case ObjectRenderbuffer: glDeleteRenderbuffers(1, &req.id); break;
+			}
+		}
+		myGpuMemoryUsage -= req.size;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GpuContext::disposeResources()
+{
+	myResourceLock.lock();
+	for(GpuResource* res = myFirstResource; res != NULL; res = res->myNextResource)
+	{
+		res->dispose();
+	}
+	myResourceLock.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+bool GpuResourceLruSortOp(GpuResource* r1, GpuResource* r2)
+{ return r1->getLastUseFrame() < r2->getLastUseFrame(); }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+int GpuContext::evictResources(size_t budget)
+{
+	int evicted = 0;
+
+	// Keep the resource lock for the whole eviction, so no candidate can be
+	// unregistered by a destructor running on another thread.
+	myResourceLock.lock();
+
+	// Collect evictable resources that have not been used during this frame.
+	// Resources used this frame are never evicted, since they would be 
+	// re-created immediately.
+	List<GpuResource*> candidates;
+	for(GpuResource* res = myFirstResource; res != NULL; res = res->myNextResource)
+	{
+		if(res->isEvictable() && res->getLastUseFrame() < myFrameNum)
+		{
+			candidates.push_back(res);
+		}
+	}
+	candidates.sort(GpuResourceLruSortOp);
+
+	// Release least recently used resources until we are back within budget.
+	foreach(GpuResource* res, candidates)
+	{
+		if(myGpuMemoryUsage <= budget) break;
+		res->evict();
+		evicted++;
+	}
+	myResourceLock.unlock();
+
+	return evicted;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GpuResource::GpuResource(GpuContext* ctx): 
+	myContext(ctx), 
+	myGpuMemorySize(0), 
+	myLastUseFrame(0),
+	myRegistered(false),
+	myPrevResource(NULL),
+	myNextResource(NULL)
+{
+	if(myContext != NULL) myContext->addResource(this);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+GpuResource::~GpuResource()
+{
+	unregister();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void GpuResource::unregister()
+{
+	if(myContext != NULL) myContext->removeResource(this);
+}
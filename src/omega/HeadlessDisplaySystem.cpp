@@ -0,0 +1,423 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	A display system that runs the omegalib engine loop without opening any
+ *  window or graphics context.
+ ******************************************************************************/
+#include "omega/HeadlessDisplaySystem.h"
+#include "omega/SystemManager.h"
+#include "omega/Engine.h"
+#include "omega/EventSharingModule.h"
+
+using namespace omega;
+
+// Slave instances of a local cluster are launched with a master hostname
+// string in the form <prefix><slave index>
+#define SLAVE_HOST_PREFIX "headless-"
+
+///////////////////////////////////////////////////////////////////////////////
+HeadlessDisplaySystem::HeadlessDisplaySystem():
+    mySys(NULL),
+    myFrameTime(0),
+    myMaxFps(0),
+    myMaxFrames(0),
+    myFrameCount(0),
+    myLocalSlaves(0),
+    mySlaveIndex(-1),
+    myTransportTimeout(10)
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+HeadlessDisplaySystem::~HeadlessDisplaySystem()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::setup(Setting& scfg) 
+{
+    // Load the standard display configuration: this lets applications use
+    // the display geometry (i.e. for view ray computations) exactly like 
+    // they would on the real display system.
+    DisplayConfig::LoadConfig(scfg, myDisplayConfig);
+
+    myFrameTime = Config::getFloatValue("frameTime", scfg, 0);
+    myMaxFps = Config::getFloatValue("maxFps", scfg, 0);
+    myMaxFrames = Config::getIntValue("maxFrames", scfg, 0);
+
+    myCanvasSize = myDisplayConfig.canvasPixelSize;
+    if(scfg.exists("canvasSize"))
+    {
+        myCanvasSize = Config::getVector2iValue("canvasSize", scfg);
+        myDisplayConfig.canvasPixelSize = myCanvasSize;
+    }
+
+    ofmsg("HeadlessDisplaySystem: frame time %1% max fps %2% max frames %3% canvas %4%",
+        %myFrameTime %myMaxFps %myMaxFrames %myCanvasSize);
+
+    // Local cluster setup
+    // (sharedMemorySlots and sharedMemorySlotSize are read by DisplayConfig)
+    myLocalSlaves = Config::getIntValue("localSlaves", scfg, 0);
+    myTransportTimeout = Config::getFloatValue("transportTimeout", scfg, 10);
+
+    SystemManager* sys = SystemManager::instance();
+    if(!sys->isMaster())
+    {
+        myLocalSlaves = 0;
+        String host = sys->getHostname();
+        if(host.find(SLAVE_HOST_PREFIX) == 0)
+        {
+            mySlaveIndex = atoi(host.substr(strlen(SLAVE_HOST_PREFIX)).c_str());
+        }
+        else
+        {
+            ofwarn("HeadlessDisplaySystem: unexpected slave host name %1%", %host);
+            mySlaveIndex = 0;
+        }
+    }
+
+    if(isLocalCluster())
+    {
+        SharedDataServices::setSharedData(&mySharedData);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::initialize(SystemManager* sys)
+{
+    mySys = sys;
+
+    // The ring name needs to be the same for all instances, and different for
+    // separate applications (or application instances in multi-instance mode)
+    String ringName = ostr("omegalib-headless-%1%", %myDisplayConfig.basePort);
+    if(myLocalSlaves > 0)
+    {
+        myRing = SharedMemoryRing::create(ringName, 
+            myDisplayConfig.sharedMemorySlots, 
+            (size_t)myDisplayConfig.sharedMemorySlotSize * 1024, myLocalSlaves);
+        if(myRing == NULL)
+        {
+            oferror("HeadlessDisplaySystem: could not create shared memory ring %1%", %ringName);
+            myLocalSlaves = 0;
+        }
+        else
+        {
+            launchSlaves();
+        }
+    }
+    else if(mySlaveIndex >= 0)
+    {
+        myRing = SharedMemoryRing::open(ringName, mySlaveIndex, myTransportTimeout);
+        if(myRing == NULL)
+        {
+            oferror("HeadlessDisplaySystem: slave %1% could not open shared memory ring %2%", 
+                %mySlaveIndex %ringName);
+            sys->postExitRequest();
+        }
+    }
+
+    ApplicationBase* app = sys->getApplication();
+    myEngine = new Engine(app);
+    myEngine->initialize();
+
+    // Setup cameras for each tile, like the other display systems do, so code
+    // looking up tile cameras keeps working.
+    typedef KeyValue<String, DisplayTileConfig*> TileItem;
+    foreach(TileItem dtc, myDisplayConfig.tiles)
+    {
+        if(dtc->cameraName == "")
+        {
+            dtc->camera = myEngine->getDefaultCamera();
+        }
+        else
+        {
+            Camera* customCamera = myEngine->getCamera(dtc->cameraName);
+            if(customCamera == NULL)
+            {
+                customCamera = myEngine->createCamera(dtc->cameraName);
+            }
+            dtc->camera = customCamera;
+        }	
+    }
+
+    StatsManager* sm = sys->getStatsManager();
+    myFpsStat = sm->createStat("fps", StatsManager::Fps);
+    myFrameTimeStat = sm->createStat("Headless frame", StatsManager::Time);
+
+    if(isLocalCluster())
+    {
+        mySharedDataApplyStat = sm->createStat("Shared data apply", StatsManager::Time);
+        mySharedDataLatencyStat = sm->createStat("Shared data latency", StatsManager::Time);
+    }
+    if(myLocalSlaves > 0)
+    {
+        mySharedDataBytesStat = sm->createStat("Shared data bytes", StatsManager::Count1);
+        mySharedDataCommitStat = sm->createStat("Shared data commit", StatsManager::Time);
+
+        // Slaves have been booting while we initialized. Wait for them here
+        // so the first frames are not sent to an incomplete cluster.
+        myRing->waitForReaders(myTransportTimeout);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::launchSlaves()
+{
+    String launcher = myDisplayConfig.nodeLauncher;
+    if(launcher == "") launcher = "%c";
+
+    String executable = StringUtils::replaceAll(launcher, "%c", mySys->getApplication()->getExecutableName());
+    executable = StringUtils::replaceAll(executable, "%h", "localhost");
+    executable = StringUtils::replaceAll(executable, "%d", ogetcwd());
+
+    for(int i = 0; i < myLocalSlaves; i++)
+    {
+        String cmd = ostr("%1% -c %2%@%3%%4% -D %5%", 
+            %executable 
+            %mySys->getAppConfig()->getFilename() 
+            %SLAVE_HOST_PREFIX %i
+            %ogetdataprefix());
+        ofmsg("HeadlessDisplaySystem: launching slave %1%: %2%", %i %cmd);
+        olaunch(cmd);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::commitSharedData()
+{
+    mySharedDataCommitStat->startTiming();
+
+    mySharedDataBuffer.clear();
+    SharedOStream out(&mySharedDataBuffer);
+    mySharedData.serializeObjects(out);
+
+    size_t size = mySharedDataBuffer.size();
+    if(!myRing->write(size > 0 ? &mySharedDataBuffer[0] : NULL, size, myTransportTimeout))
+    {
+        // Slaves can't skip a frame without going out of sync with the 
+        // master, and there is no other transport to fall back to: stop the
+        // cluster. Slaves exit when the ring is shut down.
+        oferror("HeadlessDisplaySystem: shared data frame (%1% bytes) does not fit the "
+            "shared memory ring, exiting. HINT: increase sharedMemorySlotSize", %size);
+        mySys->postExitRequest("shared data frame too big");
+    }
+    mySharedDataCommitStat->stopTiming();
+    mySharedDataBytesStat->addSample(size);
+
+    // Collect the stats reported by the slowest slave for its last frame.
+    float applyTime;
+    float latency;
+    myRing->getReaderStats(applyTime, latency);
+    if(myRing->getFramesWritten() > 1)
+    {
+        mySharedDataApplyStat->addSample(applyTime);
+        mySharedDataLatencyStat->addSample(latency);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool HeadlessDisplaySystem::updateSharedData()
+{
+    double timestamp;
+    if(!myRing->read(mySharedDataBuffer, timestamp, myTransportTimeout))
+    {
+        if(myRing->isShutdown())
+        {
+            omsg("HeadlessDisplaySystem: master shut down, exiting");
+        }
+        else
+        {
+            owarn("HeadlessDisplaySystem: master not responding, exiting");
+        }
+        return false;
+    }
+
+    // This also dispatches shared events to the engine, through the 
+    // EventSharingModule.
+    mySharedDataApplyStat->startTiming();
+    size_t size = mySharedDataBuffer.size();
+    SharedIStream in(size > 0 ? &mySharedDataBuffer[0] : NULL, size);
+    mySharedData.deserializeObjects(in);
+    mySharedDataApplyStat->stopTiming();
+
+    myEngine->update(mySharedData.getUpdateContext());
+
+    float latency = (float)((SharedMemoryRing::getTime() - timestamp) * 1000);
+    mySharedDataLatencyStat->addSample(latency);
+    myRing->setReaderStats(mySharedDataApplyStat->getCur(), latency);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::runFrame(const UpdateContext& uc)
+{
+    myFrameTimeStat->startTiming();
+
+    // Clear the event sharing queue. In local cluster mode the queue is sent
+    // to slaves during commitSharedData. Otherwise, we just drop the previous
+    // frame events here.
+    EventSharingModule::clearQueue();
+
+    ServiceManager* im = mySys->getServiceManager();
+    im->poll();
+    int av = im->getAvailableEvents();
+    if(av != 0)
+    {
+        im->lockEvents();
+        for( int evtNum = 0; evtNum < av; evtNum++)
+        {
+            Event* evt = im->getEvent(evtNum);
+            myEngine->handleEvent(*evt);
+            if(myLocalSlaves > 0 && !EventSharingModule::isLocal(*evt))
+            {
+                uint flags = evt->getFlags();
+                evt->clearFlags();
+                evt->setFlags(flags & ~Event::Processed);
+                EventSharingModule::share(*evt);
+            }
+        }
+        im->unlockEvents();
+    }
+    im->clearEvents();
+
+    if(myLocalSlaves > 0)
+    {
+        mySharedData.setUpdateContext(uc);
+        commitSharedData();
+    }
+
+    myEngine->update(uc);
+
+    myFrameTimeStat->stopTiming();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::run()
+{
+    omsg(">>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>> APPLICATION LOOP (HEADLESS)");
+
+    Timer timer;
+    timer.start();
+
+    if(mySlaveIndex >= 0)
+    {
+        // Slave instances of a local cluster run in lockstep with the master:
+        // each frame update context comes from the master shared data.
+        while(!mySys->isExitRequested() && myRing != NULL)
+        {
+            if(!updateSharedData()) break;
+            myFrameCount++;
+        }
+        mySys->postExitRequest();
+        omsg("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< APPLICATION LOOP (HEADLESS)\n\n");
+        return;
+    }
+
+    UpdateContext uc;
+    uc.frameNum = 0;
+    uc.time = 0;
+    uc.dt = 0;
+
+    double lt = timer.getElapsedTimeInSec();
+    double startTime = lt;
+    bool exitRequestProcessed = false;
+    while(!exitRequestProcessed)
+    {
+        double t = timer.getElapsedTimeInSec();
+        if(myFrameTime > 0)
+        {
+            // Fixed clock: time advances by the same amount every frame, 
+            // independently of how long frames actually take.
+            uc.dt = myFrameTime;
+        }
+        else
+        {
+            uc.dt = (float)(t - lt);
+        }
+        uc.time += uc.dt;
+        lt = t;
+
+        // Update fps stats every 10 frames.
+        if(uc.frameNum % 10 == 0 && uc.dt > 0.0f)
+        {
+            myFpsStat->addSample(1.0f / uc.dt);
+        }
+
+        runFrame(uc);
+        uc.frameNum++;
+        myFrameCount++;
+
+        if(myMaxFrames != 0 && myFrameCount >= myMaxFrames && !mySys->isExitRequested())
+        {
+            ofmsg("HeadlessDisplaySystem: %1% frames done, exiting", %myFrameCount);
+            mySys->postExitRequest();
+        }
+
+        if(mySys->isExitRequested())
+        {
+            // Run one additional frame, to give all omegalib objects
+            // a chance to dispose correctly.
+            exitRequestProcessed = true;
+            uc.frameNum++;
+            runFrame(uc);
+        }
+        else if(myMaxFps > 0)
+        {
+            double frameEnd = t + 1.0 / myMaxFps;
+            double now = timer.getElapsedTimeInSec();
+            if(now < frameEnd) osleep((uint)((frameEnd - now) * 1000));
+        }
+    }
+
+    // Tell local slaves we are done.
+    if(myRing != NULL) myRing->shutdown();
+
+    double totalTime = timer.getElapsedTimeInSec() - startTime;
+    if(myFrameCount > 0)
+    {
+        ofmsg("HeadlessDisplaySystem: %1% frames in %2%s (avg frame %3%ms)",
+            %myFrameCount %totalTime %(totalTime * 1000 / myFrameCount));
+    }
+
+    omsg("<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<< APPLICATION LOOP (HEADLESS)\n\n");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void HeadlessDisplaySystem::cleanup()
+{
+    myRing = NULL;
+    if(myEngine != NULL)
+    {
+        myEngine->dispose();
+        myEngine = NULL;
+    }
+}
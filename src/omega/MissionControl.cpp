@@ -56,6 +56,41 @@ const char* MissionControlMessageIds::ClientConnected = "ccon";
 const char* MissionControlMessageIds::ClientDisconnected = "dcon";
 const char* MissionControlMessageIds::ClientList = "clls";
 
+///////////////////////////////////////////////////////////////////////////////
+// Cluster stats are exposed to mission control using stat ids in the form
+// <stat>@<node> for a single node, <stat>@cluster for the aggregate over all
+// nodes and <stat>@outlier for the slowest node. This function appends the
+// stat update string for one of these ids. For the aggregate, min and max are
+// the lowest and highest node averages and cur is the outlier node current
+// value. For the outlier, the node name is appended to the returned stat id.
+static bool appendClusterStatUpdate(StatsManager* sm, const String& id, String& out)
+{
+    size_t sep = id.rfind('@');
+    if(sep == String::npos) return false;
+    ClusterStat* cs = sm->findClusterStat(id.substr(0, sep));
+    if(cs == NULL || cs->getNumNodes() == 0) return false;
+
+    String node = id.substr(sep + 1);
+    ClusterStat::NodeSummaries& nodes = cs->getNodeSummaries();
+    if(node == "cluster")
+    {
+        const StatSummary& outlier = nodes[cs->getOutlierNode()];
+        out.append(ostr("%1% %2% %3% %4% %5% ", %id %(int)outlier.cur 
+            %(int)cs->getMinAvg() %(int)cs->getMaxAvg() %(int)cs->getAvg()));
+        return true;
+    }
+    String statId = id;
+    if(node == "outlier")
+    {
+        node = cs->getOutlierNode();
+        statId = ostr("%1%:%2%", %id %node);
+    }
+    if(nodes.find(node) == nodes.end()) return false;
+    const StatSummary& s = nodes[node];
+    out.append(ostr("%1% %2% %3% %4% %5% ", %statId %(int)s.cur %(int)s.min %(int)s.max %(int)s.avg));
+    return true;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 MissionControlConnection::MissionControlConnection(ConnectionInfo ci, IMissionControlMessageHandler* msgHandler, MissionControlServer* server): 
@@ -431,7 +466,8 @@ bool MissionControlClient::handleMessage(
         myConnectedClients = StringUtils::split(list, " ");
         if(interp != NULL && !myClientListUpdatedCommand.empty())
         {
-            interp->queueCommand(myClientListUpdatedCommand);
+            // Only the latest client list update needs to run.
+            interp->queueCommand(myClientListUpdatedCommand, false, "missionControl.clientListUpdated");
         }
     }
     else if(!strncmp(header, MissionControlMessageIds::ClientConnected, 4))
@@ -490,6 +526,17 @@ bool MissionControlClient::handleMessage(
                 statIds.append(s->getName());
                 statIds.append("|");
             }
+            // On the master of a cluster, also list the cluster stats.
+            typedef KeyValue<String, StatSummary> NodeItem;
+            foreach(ClusterStat* cs, sm->getClusterStats())
+            {
+                statIds.append(cs->getName() + "@cluster|");
+                statIds.append(cs->getName() + "@outlier|");
+                foreach(NodeItem item, cs->getNodeSummaries())
+                {
+                    statIds.append(cs->getName() + "@" + item.getKey() + "|");
+                }
+            }
             sender->sendMessage(MissionControlMessageIds::StatRequest, (void*)statIds.c_str(), statIds.size());
         }
     }
@@ -501,6 +548,7 @@ bool MissionControlClient::handleMessage(
             // Set enabled stats.
             String stats(data);
             myEnabledStats.clear();
+            myEnabledClusterStats.clear();
             std::vector<String> statVector = StringUtils::tokenise(stats, " ");
             foreach(String statId, statVector)
             {
@@ -509,12 +557,18 @@ bool MissionControlClient::handleMessage(
                 {
                     myEnabledStats.push_back(s);
                 }
+                else if(statId.find('@') != String::npos)
+                {
+                    // Cluster stat. Nodes may report it later, so we do 
+                    // not check it exists here.
+                    myEnabledClusterStats.push_back(statId);
+                }
             }
         }
     }
     if(!strncmp(header, MissionControlMessageIds::StatUpdate, 4)) 
     {
-        if(myEnabledStats.size() > 0)
+        if(myEnabledStats.size() > 0 || myEnabledClusterStats.size() > 0)
         {
             // Request for stats update.
             String statIds = "";
@@ -522,6 +576,11 @@ bool MissionControlClient::handleMessage(
             {
                 statIds.append(ostr("%1% %2% %3% %4% %5% ", %s->getName() %(int)s->getCur() %(int)s->getMin() %(int)s->getMax() %(int)s->getAvg()));
             }
+            StatsManager* sm = SystemManager::instance()->getStatsManager();
+            foreach(String statId, myEnabledClusterStats)
+            {
+                appendClusterStatUpdate(sm, statId, statIds);
+            }
             sender->sendMessage(MissionControlMessageIds::StatUpdate, (void*)statIds.c_str(), statIds.size());
         }
     }
@@ -59,6 +59,7 @@ void MouseService::mouseWheelCallback(int btn, int wheel, int x, int y)
 		}
 
 		mysInstance->lockEvents();
+		mysInstance->flushMotion();
 
 		Event* evt = mysInstance->writeHead();
 		evt->reset(Event::Zoom, Service::Pointer);
@@ -87,17 +88,23 @@ void MouseService::mouseMotionCallback(int x, int y)
 		x = x * screenX / serverX + screenOffsetX;
 		y = y * screenY / serverY + screenOffsetY;
 
-		Event* evt = mysInstance->writeHead();
-		evt->reset(Event::Move, Service::Pointer);
-		evt->setPosition(x, y);
-		evt->setFlags(sButtonFlags);
+		// Accumulate the pointer path length.
+		Vector2i pos(x, y);
+		if(mysInstance->myMotionPositionValid)
+		{
+			Vector2i d = pos - mysInstance->myMotionPosition;
+			mysInstance->myMotionPathLength += sqrt((float)(d[0] * d[0] + d[1] * d[1]));
+		}
+		mysInstance->myMotionPosition = pos;
+		mysInstance->myMotionPositionValid = true;
 
-		DisplaySystem* ds = SystemManager::instance()->getDisplaySystem();
-		mysInstance->myPointerRay = ds->getViewRay(Vector2i(x, y));
+		if(mysInstance->myMotionPending) mysInstance->myCoalescedCount++;
+		mysInstance->myMotionPending = true;
+		mysInstance->myMotionMergedCount++;
 
-		evt->setExtraDataType(Event::ExtraDataVector3Array);
-		evt->setExtraDataVector3(0, mysInstance->myPointerRay.getOrigin());
-		evt->setExtraDataVector3(1, mysInstance->myPointerRay.getDirection());
+		// Without coalescing, motion events are written right away. Otherwise
+		// they are written at the next poll, or before the next button event.
+		if(!mysInstance->myMotionCoalescingEnabled) mysInstance->flushMotion();
 
 		mysInstance->unlockEvents();
 	}
@@ -116,6 +123,7 @@ void MouseService::mouseButtonCallback(int button, int state, int x, int y)
 		}
 
 		mysInstance->lockEvents();
+		mysInstance->flushMotion();
 
 		x = x * screenX / serverX + screenOffsetX;
 		y = y * screenY / serverY + screenOffsetY;
@@ -174,10 +182,66 @@ void MouseService::mouseButtonCallback(int button, int state, int x, int y)
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-MouseService::MouseService()
+MouseService::MouseService():
+	myMotionCoalescingEnabled(false),
+	myMotionPathLengthEnabled(false),
+	myMotionPending(false),
+	myMotionPositionValid(false),
+	myMotionPathLength(0),
+	myMotionMergedCount(0),
+	myCoalescedCount(0)
 {
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void MouseService::flushMotion()
+{
+	if(!myMotionPending) return;
+
+	int x = myMotionPosition[0];
+	int y = myMotionPosition[1];
+
+	Event* evt = writeHead();
+	evt->reset(Event::Move, Service::Pointer);
+	evt->setPosition(x, y);
+	evt->setFlags(sButtonFlags);
+
+	DisplaySystem* ds = SystemManager::instance()->getDisplaySystem();
+	myPointerRay = ds->getViewRay(myMotionPosition);
+
+	evt->setExtraDataType(Event::ExtraDataVector3Array);
+	evt->setExtraDataVector3(0, myPointerRay.getOrigin());
+	evt->setExtraDataVector3(1, myPointerRay.getDirection());
+	if(myMotionPathLengthEnabled)
+	{
+		evt->setExtraDataVector3(2, Vector3f(myMotionPathLength, (float)myMotionMergedCount, 0));
+	}
+
+	myMotionPending = false;
+	myMotionPathLength = 0;
+	myMotionMergedCount = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void MouseService::poll()
+{
+	lockEvents();
+	flushMotion();
+	int coalesced = myCoalescedCount;
+	myCoalescedCount = 0;
+	unlockEvents();
+
+	if(myMotionCoalescingEnabled)
+	{
+		if(myCoalescedEventsStat == NULL)
+		{
+			StatsManager* sm = SystemManager::instance()->getStatsManager();
+			myCoalescedEventsStat = sm->createStat("Mouse motion events coalesced", StatsManager::Count1);
+		}
+		myCoalescedEventsStat->addSample(coalesced);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void MouseService::setPointerRay(const Ray& ray)
 {
@@ -215,6 +279,8 @@ void MouseService::setup(Setting& settings)
 	{
 		screenOffsetY =  settings["screenOffsetY"];
 	}
+	myMotionCoalescingEnabled = Config::getBoolValue("coalesceMotion", settings, myMotionCoalescingEnabled);
+	myMotionPathLengthEnabled = Config::getBoolValue("motionPathLength", settings, myMotionPathLengthEnabled);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
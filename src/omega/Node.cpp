@@ -792,3 +792,86 @@ void Node::cancelUpdate(Node* child)
         mParentNotified = false ;
     }
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void NodeGroup::addNode(Node* node)
+{
+    if(node == NULL)
+    {
+        owarn("NodeGroup::addNode: node is NULL");
+        return;
+    }
+    myNodes.push_back(node);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void NodeGroup::removeNode(Node* node)
+{
+    for(size_t i = 0; i < myNodes.size(); i++)
+    {
+        if(myNodes[i] == node)
+        {
+            myNodes.erase(myNodes.begin() + i);
+            return;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void NodeGroup::setTransforms(const float* positions, const float* orientations, const float* scales)
+{
+    if(positions == NULL && orientations == NULL && scales == NULL) return;
+
+    int n = myNodes.size();
+    for(int i = 0; i < n; i++)
+    {
+        Node* node = myNodes[i];
+        if(node == NULL) continue;
+        if(positions != NULL)
+        {
+            const float* p = positions + i * 3;
+            node->mPosition = Vector3f(p[0], p[1], p[2]);
+        }
+        if(orientations != NULL)
+        {
+            const float* q = orientations + i * 4;
+            node->mOrientation = Quaternion(q[0], q[1], q[2], q[3]);
+            node->mOrientation.normalize();
+        }
+        if(scales != NULL)
+        {
+            const float* s = scales + i * 3;
+            node->mScale = Vector3f(s[0], s[1], s[2]);
+        }
+        node->needUpdate();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void NodeGroup::getDerivedTransforms(float* positions, float* orientations, float* scales)
+{
+    int n = myNodes.size();
+    for(int i = 0; i < n; i++)
+    {
+        Node* node = myNodes[i];
+        if(node == NULL) continue;
+        if(positions != NULL)
+        {
+            const Vector3f& p = node->getDerivedPosition();
+            float* dst = positions + i * 3;
+            dst[0] = p[0]; dst[1] = p[1]; dst[2] = p[2];
+        }
+        if(orientations != NULL)
+        {
+            const Quaternion& q = node->getDerivedOrientation();
+            float* dst = orientations + i * 4;
+            dst[0] = q.w(); dst[1] = q.x(); dst[2] = q.y(); dst[3] = q.z();
+        }
+        if(scales != NULL)
+        {
+            const Vector3f& s = node->getDerivedScale();
+            float* dst = scales + i * 3;
+            dst[0] = s[0]; dst[1] = s[1]; dst[2] = s[2];
+        }
+    }
+}
@@ -41,7 +41,18 @@ ObserverUpdateServiceExt::ObserverUpdateServiceExt():
 	myUseHeadPointId(false),
 	myDynamicSourceTokenId(0),
 	myDynamicSourceTokenAttachPoint(AttachHead),
-	myDynamicSourceActivationDistance(0.1f)
+	myDynamicSourceActivationDistance(0.1f),
+	myPredictionEnabled(false),
+	myPredictionInitialized(false),
+	myPredictionLatency(0.03f),
+	myPredictionAlpha(0.5f),
+	myPredictionBeta(0.1f),
+	myPredictionMaxSpeed(5.0f),
+	myLastSampleTimestamp(0),
+	mySampleTime(0),
+	myPredictionPending(false),
+	myPendingPredictionTime(0),
+	myFrameTime(1.0f / 60)
 {
 	myLookAt = Vector3f::Zero();
 	setPollPriority(Service::PollLast);
@@ -98,6 +109,16 @@ void ObserverUpdateServiceExt::setup(Setting& settings)
 		myOrientationSourceId = st["sourceId"];
 		myEnableOrientationSource = true;
 	}
+	if(settings.exists("headPrediction"))
+	{
+		Setting& st = settings["headPrediction"];
+		myPredictionEnabled = Config::getBoolValue("enabled", st, true);
+		// Latency is specified in milliseconds.
+		myPredictionLatency = Config::getFloatValue("latency", st, myPredictionLatency * 1000) / 1000;
+		myPredictionAlpha = Config::getFloatValue("alpha", st, myPredictionAlpha);
+		myPredictionBeta = Config::getFloatValue("beta", st, myPredictionBeta);
+		myPredictionMaxSpeed = Config::getFloatValue("maxSpeed", st, myPredictionMaxSpeed);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -105,11 +126,28 @@ void ObserverUpdateServiceExt::initialize()
 {
 	DisplaySystem* ds = SystemManager::instance()->getDisplaySystem();
 	myObserver = Engine::instance()->getDefaultCamera();
+
+	if(myPredictionEnabled)
+	{
+		StatsManager* sm = SystemManager::instance()->getStatsManager();
+		myPredictionErrorStat = sm->createStat("Head prediction error (mm)", StatsManager::Count1);
+		myFrameTimer.start();
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void ObserverUpdateServiceExt::poll()
 {
+	if(myPredictionEnabled)
+	{
+		// Measure the frame time, used to predict the head position at the 
+		// time the next frame will be displayed.
+		myFrameTimer.stop();
+		float ft = (float)myFrameTimer.getElapsedTimeInMilliSec() / 1000;
+		myFrameTimer.start();
+		if(ft > 0 && ft < 0.5f) myFrameTime = myFrameTime * 0.9f + ft * 0.1f;
+	}
+
 	lockEvents();
 	int numEvts = getManager()->getAvailableEvents();
 	//myObserver->updateHead(myLastPosition, Quaternion::Identity());
@@ -150,17 +188,25 @@ void ObserverUpdateServiceExt::poll()
 						q = myLastOrientation;
 					}
 
-					float d = (myLastPosition - pos).norm();
-					if(d > myCurrentMovementThreshold)
+					if(myPredictionEnabled)
+					{
+						// The prediction filter replaces the movement threshold.
+						myObserver->setHeadOffset(predictHeadPosition(pos, evt->getTimestamp()));
+					}
+					else
 					{
-						//if(myCurrentMovementThreshold > (myMovementThresholdTarget - 0.01f)) myCurrentMovementThreshold = 0;
-						myCurrentMovementThreshold = 0.01f;
+						float d = (myLastPosition - pos).norm();
+						if(d > myCurrentMovementThreshold)
+						{
+							//if(myCurrentMovementThreshold > (myMovementThresholdTarget - 0.01f)) myCurrentMovementThreshold = 0;
+							myCurrentMovementThreshold = 0.01f;
 
-						myLastPosition = pos;
+							myLastPosition = pos;
+						}
+						myCurrentMovementThreshold = (myCurrentMovementThreshold * myMovementThresholdCoeff + myMovementThresholdTarget) / (myMovementThresholdCoeff + 1);
+						//ofmsg("mvth: %1%", %myCurrentMovementThreshold);
+						myObserver->setHeadOffset(myLastPosition);
 					}
-					myCurrentMovementThreshold = (myCurrentMovementThreshold * myMovementThresholdCoeff + myMovementThresholdTarget) / (myMovementThresholdCoeff + 1);
-					//ofmsg("mvth: %1%", %myCurrentMovementThreshold);
-					myObserver->setHeadOffset(myLastPosition);
 					myObserver->setHeadOrientation(q);
 				}
 			}
@@ -174,6 +220,70 @@ void ObserverUpdateServiceExt::poll()
 	unlockEvents();
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+Vector3f ObserverUpdateServiceExt::predictHeadPosition(const Vector3f& pos, uint timestamp)
+{
+	// Use event timestamps (in milliseconds) to measure the time between 
+	// samples. If the tracker does not provide distinct timestamps, assume 
+	// one sample per frame.
+	float dt = (float)(timestamp - myLastSampleTimestamp) / 1000;
+	if(timestamp <= myLastSampleTimestamp) dt = myFrameTime;
+	myLastSampleTimestamp = timestamp;
+
+	if(!myPredictionInitialized || dt > 0.5f)
+	{
+		// First sample or tracking gap: restart the filter.
+		myFilteredPosition = pos;
+		myFilteredVelocity = Vector3f::Zero();
+		myPredictionInitialized = true;
+		myPredictionPending = false;
+		mySampleTime = 0;
+		myLastSamplePosition = pos;
+		return pos;
+	}
+
+	// Check the position extrapolated on a previous frame once the samples 
+	// reach its target time, interpolating the head position at that time.
+	float sampleTime = mySampleTime + dt;
+	if(myPredictionPending && sampleTime >= myPendingPredictionTime)
+	{
+		float t = (myPendingPredictionTime - mySampleTime) / dt;
+		if(t < 0) t = 0;
+		Vector3f actual = myLastSamplePosition + (pos - myLastSamplePosition) * t;
+		myPredictionErrorStat->addSample((actual - myPendingPrediction).norm() * 1000);
+		myPredictionPending = false;
+	}
+	mySampleTime = sampleTime;
+	myLastSamplePosition = pos;
+
+	// Constant velocity model: predict the position at the sample time, then
+	// correct position and velocity using the prediction residual.
+	Vector3f predicted = myFilteredPosition + myFilteredVelocity * dt;
+	Vector3f residual = pos - predicted;
+
+	myFilteredPosition = predicted + residual * myPredictionAlpha;
+	myFilteredVelocity += residual * (myPredictionBeta / dt);
+	float speed = myFilteredVelocity.norm();
+	if(speed > myPredictionMaxSpeed) myFilteredVelocity *= myPredictionMaxSpeed / speed;
+
+	if(myDebug)
+	{
+		ofmsg("Observer filtered pos: %1% velocity: %2%", %myFilteredPosition %myFilteredVelocity);
+	}
+
+	// Extrapolate to the expected display time. One extrapolation at a time
+	// is tracked for the prediction error stat.
+	float interval = myPredictionLatency + myFrameTime;
+	Vector3f extrapolated = myFilteredPosition + myFilteredVelocity * interval;
+	if(!myPredictionPending)
+	{
+		myPredictionPending = true;
+		myPendingPrediction = extrapolated;
+		myPendingPredictionTime = mySampleTime + interval;
+	}
+	return extrapolated;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void ObserverUpdateServiceExt::dispose()
 {
@@ -52,7 +52,9 @@ PixelData::PixelData(Format fmt, int width, int height, byte* data, uint usageFl
 	myFormat(fmt),
 	mySize(0),
 	myDeleteDisabled(false),
-	myChangingPixels(false)
+	myChangingPixels(false),
+	myMappingCount(0),
+	myMappedRefreshFrame(0)
 	//myDirty(true)
 {
 	setDirty(true);
@@ -114,6 +116,13 @@ void PixelData::resize(int width, int height)
 	if(width != myWidth || height != myHeight)
 	{
 		myLock.lock();
+		// External code may be holding a pointer to the pixel memory.
+		if(myMappingCount > 0)
+		{
+			myLock.unlock();
+			owarn("PixelData::resize: cannot resize mapped pixel data");
+			return;
+		}
 
 		myWidth = width;
 		myHeight = height;
@@ -181,6 +190,41 @@ void PixelData::unmap()
 	myLock.unlock();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+byte* PixelData::retainMapping()
+{
+	if(checkUsage(PixelBufferObject)) return NULL;
+	myLock.lock();
+	myMappingCount++;
+	byte* data = myData;
+	myLock.unlock();
+	return data;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PixelData::releaseMapping()
+{
+	myLock.lock();
+	if(myMappingCount > 0) myMappingCount--;
+	myLock.unlock();
+	setDirty();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+Texture* PixelData::getTexture(const DrawContext& context)
+{
+	// Mapped data may have been modified since the last draw: refresh the
+	// texture once per frame until all mappings are released. setDirty
+	// flags textures on all contexts, so only the first call in a frame
+	// needs to do it.
+	if(myMappingCount > 0 && context.frameNum != myMappedRefreshFrame)
+	{
+		myMappedRefreshFrame = context.frameNum;
+		setDirty();
+	}
+	return TextureSource::getTexture(context);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 byte* PixelData::bind(const GpuContext* context)
 {
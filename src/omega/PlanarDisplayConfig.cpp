@@ -99,5 +99,52 @@ bool PlanarDisplayConfig::buildConfig(DisplayConfig& cfg, Setting& scfg)
 		//tileViewportX += tileViewportWidth;
 	}
 
+	// Register as the ray-to-point converter for 2D interaction. All tiles
+	// lie on the same plane, so the conversion is a single plane 
+	// intersection.
+	myCanvasTopLeft = canvasTopLeft;
+	myCanvasSize = Vector2f(numTiles[0] * tw, numTiles[1] * th);
+	cfg.rayToPointConverter = this;
+
 	return true;
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+std::pair<bool, Vector2f> PlanarDisplayConfig::getPointFromRay(const Ray& ray)
+{
+	std::pair<bool, Vector2f> res;
+	getPointsFromRays(&ray, 1, &res);
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void PlanarDisplayConfig::getPointsFromRays(const Ray* rays, int count, std::pair<bool, Vector2f>* points)
+{
+	float z = myCanvasTopLeft.z();
+	float invWidth = 1.0f / myCanvasSize[0];
+	float invHeight = 1.0f / myCanvasSize[1];
+
+	for(int i = 0; i < count; i++)
+	{
+		const Vector3f& dir = rays[i].getDirection();
+		const Vector3f& orig = rays[i].getOrigin();
+
+		points[i].first = false;
+		points[i].second = Vector2f::Zero();
+		if(dir.z() != 0)
+		{
+			float t = (z - orig.z()) / dir.z();
+			if(t >= 0)
+			{
+				// Normalized coordinates: pixel row 0 is at the top.
+				float x = (orig.x() + dir.x() * t - myCanvasTopLeft.x()) * invWidth;
+				float y = (myCanvasTopLeft.y() - orig.y() - dir.y() * t) * invHeight;
+				if(x >= 0 && x <= 1 && y >= 0 && y <= 1)
+				{
+					points[i].first = true;
+					points[i].second = Vector2f(x, y);
+				}
+			}
+		}
+	}
+}
@@ -51,8 +51,33 @@ const Event* PythonInterpreter::mysLastEvent = NULL;
 #endif
 #include <signal.h>  // for signal
 #include "omega/PythonInterpreterWrapper.h"
+#include "marshal.h"
 
 #include<iostream>
+#include<fstream>
+#include<sstream>
+#include<cstdio>
+#include<sys/stat.h>
+#ifdef OMEGA_OS_WIN
+	#include<process.h>
+#else
+	#include<unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns a 32 bit FNV-1a hash of the string, as 8 hex digits.
+static String getHashString(const String& str)
+{
+	uint hash = 2166136261u;
+	for(size_t i = 0; i < str.length(); i++)
+	{
+		hash ^= (unsigned char)str[i];
+		hash *= 16777619u;
+	}
+	char hashStr[16];
+	sprintf(hashStr, "%08x", hash);
+	return hashStr;
+}
 
 //struct vtkPythonMessage
 //{
@@ -128,6 +153,13 @@ PythonInterpreter::PythonInterpreter()
 {
 	myShellEnabled = false;
 	myDebugShell = false;
+	myCodeCacheSize = 256;
+	myCommandStatsEnabled = false;
+	myCallbackStatsEnabled = false;
+	myCallbackStatCount = 0;
+	myCommandBatchingEnabled = true;
+	myEventBatchMask = 0;
+	myScriptCacheDir = "";
 	myInteractiveThread = new PythonInteractiveThread();
 }
 
@@ -139,6 +171,8 @@ PythonInterpreter::~PythonInterpreter()
 	delete myInteractiveThread;
 	myInteractiveThread = NULL;
 
+	clearCodeCache();
+	clearScriptCache();
 	Py_Finalize();
 }
 
@@ -168,6 +202,11 @@ void PythonInterpreter::setup(const Setting& setting)
 	// Command read from a configuration file and executed during 
 	// initialization. Helpful to load or setup optional modules.
 	myInitCommand = Config::getStringValue("initCommand", setting, myInitCommand);
+	myCodeCacheSize = Config::getIntValue("pythonCodeCacheSize", setting, myCodeCacheSize);
+	myCommandStatsEnabled = Config::getBoolValue("pythonCommandStatsEnabled", setting, myCommandStatsEnabled);
+	myCallbackStatsEnabled = Config::getBoolValue("pythonCallbackStatsEnabled", setting, myCallbackStatsEnabled);
+	myCommandBatchingEnabled = Config::getBoolValue("pythonCommandBatchingEnabled", setting, myCommandBatchingEnabled);
+	myScriptCacheDir = Config::getStringValue("pythonScriptCacheDir", setting, myScriptCacheDir);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -267,6 +306,10 @@ void PythonInterpreter::initialize(const char* programName)
 	// Setup stats
 	StatsManager* sm = SystemManager::instance()->getStatsManager();
 	myUpdateTimeStat = sm->createStat("Script update", StatsManager::Time);
+	myCommandCountStat = sm->createStat("Script commands", StatsManager::Count1);
+	myCommandBytesStat = sm->createStat("Script command bytes", StatsManager::Count2);
+	myScriptLoadTimeStat = sm->createStat("Script load", StatsManager::Time);
+	myScriptRunTimeStat = sm->createStat("Script run", StatsManager::Time);
 	omsg("Python Interpreter initialized.");
 }
 
@@ -347,7 +390,8 @@ void PythonInterpreter::eval(const String& cscript, const char* format, ...)
 		{
 			if(myDebugShell) ofmsg("PythonInterpreter::eval() >>>> %1%", %str);
 			lockInterpreter();
-			PyRun_SimpleString(str);
+			if(myCodeCacheSize > 0) evalCompiled(script);
+			else PyRun_SimpleString(str);
 			unlockInterpreter();
 		}
 	}
@@ -375,6 +419,218 @@ void PythonInterpreter::eval(const String& cscript, const char* format, ...)
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::evalCompiled(const String& script)
+{
+	CompiledCommand* cc = getCompiledCommand(script, "<string>");
+	if(cc == NULL)
+	{
+		// Report the syntax error like PyRun_SimpleString would.
+		PyErr_Print();
+		return;
+	}
+
+	// Keep the code object and stat alive while executing: the command may
+	// clear the cache (i.e. by calling clean)
+	PyObject* code = (PyObject*)cc->code;
+	Ref<Stat> stat = cc->stat;
+	Py_INCREF(code);
+
+	PyObject* module = PyImport_AddModule("__main__");
+	PyObject* dict = PyModule_GetDict(module);
+
+	if(stat != NULL) stat->startTiming();
+	PyObject* result = PyEval_EvalCode((PyCodeObject*)code, dict, dict);
+	if(stat != NULL) stat->stopTiming();
+
+	if(result == NULL) PyErr_Print();
+	else Py_DECREF(result);
+	Py_DECREF(code);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+PythonInterpreter::CompiledCommand* PythonInterpreter::getCompiledCommand(const String& script, const char* filename)
+{
+	CompiledCommand* cc = NULL;
+	Dictionary<String, CodeCacheIterator>::iterator it = myCodeCacheIndex.find(script);
+	if(it != myCodeCacheIndex.end())
+	{
+		// Move the command to the front of the cache.
+		cc = *(it->second);
+		myCodeCache.erase(it->second);
+		myCodeCache.push_front(cc);
+		it->second = myCodeCache.begin();
+	}
+	else
+	{
+		PyObject* code = Py_CompileString(script.c_str(), filename, Py_file_input);
+		if(code == NULL) return NULL;
+		cc = new CompiledCommand();
+		cc->command = script;
+		cc->code = code;
+		if(myCommandStatsEnabled)
+		{
+			// The hash of the full command keeps stats of commands with the
+			// same prefix separate. Commands compiled again after being 
+			// discarded from the cache keep their stat.
+			String statName = script.length() > 48 ? script.substr(0, 45) + "..." : script;
+			statName = ostr("py %1% #%2%", %statName %getHashString(script));
+			StatsManager* sm = SystemManager::instance()->getStatsManager();
+			cc->stat = sm->findStat(statName);
+			if(cc->stat == NULL) cc->stat = sm->createStat(statName, StatsManager::Time);
+		}
+		myCodeCache.push_front(cc);
+		myCodeCacheIndex[script] = myCodeCache.begin();
+		trimCodeCache(myCodeCacheSize);
+	}
+	return cc;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::evalBatch(const Vector<String>& commands)
+{
+	if(commands.size() == 0) return;
+	if(commands.size() == 1)
+	{
+		eval(commands[0]);
+		return;
+	}
+
+	// Wrap each command in its own try block, so an exception in one command 
+	// does not prevent the following ones from running, like with separate
+	// evals.
+	String block;
+	foreach(const String& cmd, commands)
+	{
+		block.append("try:\n ");
+		block.append(cmd);
+		block.append("\nexcept Exception:\n __import__('traceback').print_exc()\n");
+	}
+
+	lockInterpreter();
+	// Interactive controls tend to queue the same commands every frame, so
+	// the same blocks come up again: reuse their compiled code when the 
+	// code cache is enabled.
+	PyObject* code = NULL;
+	if(myCodeCacheSize > 0)
+	{
+		CompiledCommand* cc = getCompiledCommand(block, "<command batch>");
+		if(cc != NULL)
+		{
+			// Keep the code alive while executing (the batch may clear the
+			// cache).
+			code = (PyObject*)cc->code;
+			Py_INCREF(code);
+		}
+	}
+	else
+	{
+		code = Py_CompileString(block.c_str(), "<command batch>", Py_file_input);
+	}
+	if(code == NULL)
+	{
+		// Some command has a syntax error: run the commands separately, so
+		// the error gets reported for that command only.
+		PyErr_Clear();
+		unlockInterpreter();
+		foreach(const String& cmd, commands) eval(cmd);
+		return;
+	}
+
+	PyObject* module = PyImport_AddModule("__main__");
+	PyObject* dict = PyModule_GetDict(module);
+	PyObject* result = PyEval_EvalCode((PyCodeObject*)code, dict, dict);
+	if(result == NULL) PyErr_Print();
+	else Py_DECREF(result);
+	Py_DECREF(code);
+	unlockInterpreter();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::trimCodeCache(int maxSize)
+{
+	while((int)myCodeCache.size() > maxSize)
+	{
+		CompiledCommand* cc = myCodeCache.back();
+		myCodeCache.pop_back();
+		myCodeCacheIndex.erase(cc->command);
+		Py_DECREF((PyObject*)cc->code);
+		delete cc;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::setCodeCacheSize(int value)
+{
+	myCodeCacheSize = value;
+	trimCodeCache(value > 0 ? value : 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::setCommandStatsEnabled(bool value)
+{
+	myCommandStatsEnabled = value;
+	// Drop cached commands, so they get recompiled with (or without) stats.
+	clearCodeCache();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::clearCodeCache()
+{
+	trimCodeCache(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::setCallbackStatsEnabled(bool value)
+{
+	myCallbackStatsEnabled = value;
+	if(!value)
+	{
+		// Release the callback stats, so they get removed from the stats 
+		// manager.
+		foreach(ScriptCallback& cb, myUpdateCallbacks) cb.stat = NULL;
+		foreach(ScriptCallback& cb, myEventCallbacks) cb.stat = NULL;
+		foreach(ScriptCallback& cb, myDrawCallbacks) cb.stat = NULL;
+		foreach(EventBatchCallback& cb, myEventBatchCallbacks) cb.stat = NULL;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+Stat* PythonInterpreter::getCallbackStat(ScriptCallback& cb, const char* type)
+{
+	if(cb.stat == NULL)
+	{
+		// Name the stat after the python function module and name, if 
+		// available. Lambdas and functions with the same name would still
+		// share a name, so we also add a registration index.
+		String name = "<callable>";
+		PyObject* pyName = PyObject_GetAttrString((PyObject*)cb.callback, "__name__");
+		if(pyName != NULL)
+		{
+			if(PyString_Check(pyName)) name = PyString_AsString(pyName);
+			Py_DECREF(pyName);
+		}
+		else
+		{
+			PyErr_Clear();
+		}
+		PyObject* pyModule = PyObject_GetAttrString((PyObject*)cb.callback, "__module__");
+		if(pyModule != NULL)
+		{
+			if(PyString_Check(pyModule)) name = ostr("%1%.%2%", %PyString_AsString(pyModule) %name);
+			Py_DECREF(pyModule);
+		}
+		else
+		{
+			PyErr_Clear();
+		}
+		StatsManager* sm = SystemManager::instance()->getStatsManager();
+		cb.stat = sm->createStat(ostr("py %1% %2% #%3%", %type %name %myCallbackStatCount), StatsManager::Time);
+		myCallbackStatCount++;
+	}
+	return cb.stat;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::evalEventCommand(const String& command, const Event& evt) 
 {
@@ -407,11 +663,10 @@ void PythonInterpreter::runFile(const String& filename, uint flags)
 
 		// NOTE: we need to read the file before (possibly) resetting the current
 		// working dir, otherwise we will not be able to find the file.
-		PyObject* PyFileObject = PyFile_FromString((char*)fullPath.c_str(), "r");
-		if(PyFileObject == NULL)
-		{
-			ofwarn("PythonInterpreter:runFile: failed to open script file %1%", %fullPath);
-		}
+		myScriptLoadTimeStat->startTiming();
+		PyObject* code = (PyObject*)loadScript(fullPath, filename);
+		myScriptLoadTimeStat->stopTiming();
+		if(code == NULL) return;
 
 		if(flags & SetCwdToScriptPath)
 		{
@@ -434,7 +689,28 @@ void PythonInterpreter::runFile(const String& filename, uint flags)
 			addPythonPath(scriptPath.c_str());
 		}
 
-		PyRun_SimpleFile(PyFile_AsFile(PyFileObject), filename.c_str());
+		// Run the script in the main module, setting __file__ while it runs
+		// like PyRun_SimpleFile does.
+		PyObject* module = PyImport_AddModule("__main__");
+		PyObject* dict = PyModule_GetDict(module);
+		bool setFileName = false;
+		if(PyDict_GetItemString(dict, "__file__") == NULL)
+		{
+			PyObject* f = PyString_FromString(filename.c_str());
+			PyDict_SetItemString(dict, "__file__", f);
+			Py_DECREF(f);
+			setFileName = true;
+		}
+
+		myScriptRunTimeStat->startTiming();
+		PyObject* result = PyEval_EvalCode((PyCodeObject*)code, dict, dict);
+		myScriptRunTimeStat->stopTiming();
+
+		if(result == NULL) PyErr_Print();
+		else Py_DECREF(result);
+		Py_DECREF(code);
+
+		if(setFileName && PyDict_DelItemString(dict, "__file__") != 0) PyErr_Clear();
 	}
 	else
 	{
@@ -442,6 +718,175 @@ void PythonInterpreter::runFile(const String& filename, uint flags)
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Name of the disk cache file for a script: the script file name plus a hash
+// of its full path, so scripts with the same name in different directories
+// do not collide.
+static String getScriptCacheFileName(const String& cacheDir, const String& fullPath)
+{
+	String baseName;
+	String dir;
+	StringUtils::splitFilename(fullPath, baseName, dir);
+	return ostr("%1%/%2%.%3%.pyc", %cacheDir %baseName %getHashString(fullPath));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void writeCacheInt(std::ostream& out, long value)
+{
+	unsigned char b[4];
+	for(int i = 0; i < 4; i++) b[i] = (unsigned char)((value >> (i * 8)) & 0xff);
+	out.write((const char*)b, 4);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static long readCacheInt(const char* data)
+{
+	const unsigned char* b = (const unsigned char*)data;
+	return (long)((uint)b[0] | ((uint)b[1] << 8) | ((uint)b[2] << 16) | ((uint)b[3] << 24));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void* PythonInterpreter::loadScript(const String& fullPath, const String& filename)
+{
+	struct stat st;
+	if(stat(fullPath.c_str(), &st) != 0)
+	{
+		ofwarn("PythonInterpreter:runFile: failed to open script file %1%", %fullPath);
+		return NULL;
+	}
+	long mtime = (long)st.st_mtime;
+	long size = (long)st.st_size;
+
+	// Memory cache lookup
+	Dictionary<String, CompiledScript>::iterator it = myScriptCache.find(fullPath);
+	if(it != myScriptCache.end())
+	{
+		CompiledScript& cs = it->second;
+		if(cs.mtime == mtime && cs.size == size)
+		{
+			Py_INCREF((PyObject*)cs.code);
+			return cs.code;
+		}
+		Py_DECREF((PyObject*)cs.code);
+		myScriptCache.erase(it);
+	}
+
+	PyObject* code = NULL;
+	long magic = PyImport_GetMagicNumber();
+
+	// Disk cache lookup. The cache file layout is: magic number, script 
+	// modification time, script size, marshalled code object.
+	String cacheFile;
+	if(myScriptCacheDir != "")
+	{
+		cacheFile = getScriptCacheFileName(myScriptCacheDir, fullPath);
+		std::ifstream in(cacheFile.c_str(), std::ios::in | std::ios::binary);
+		if(in)
+		{
+			std::stringstream buf;
+			buf << in.rdbuf();
+			String data = buf.str();
+			if(data.length() > 12 &&
+				readCacheInt(data.c_str()) == magic &&
+				readCacheInt(data.c_str() + 4) == mtime &&
+				readCacheInt(data.c_str() + 8) == size)
+			{
+				code = PyMarshal_ReadObjectFromString(
+					(char*)data.c_str() + 12, data.length() - 12);
+				if(code != NULL && !PyCode_Check(code))
+				{
+					Py_DECREF(code);
+					code = NULL;
+				}
+				if(code == NULL) PyErr_Clear();
+			}
+		}
+	}
+
+	if(code == NULL)
+	{
+		std::ifstream in(fullPath.c_str(), std::ios::in | std::ios::binary);
+		if(!in)
+		{
+			ofwarn("PythonInterpreter:runFile: failed to open script file %1%", %fullPath);
+			return NULL;
+		}
+		std::stringstream buf;
+		buf << in.rdbuf();
+		String source = StringUtils::replaceAll(buf.str(), "\r\n", "\n");
+
+		code = Py_CompileString(source.c_str(), filename.c_str(), Py_file_input);
+		if(code == NULL)
+		{
+			// Report the syntax error like PyRun_SimpleFile would.
+			PyErr_Print();
+			return NULL;
+		}
+
+		// Save the compiled code to the disk cache. Write to a temporary file
+		// first, since other nodes may be reading the cache at the same time.
+		if(cacheFile != "")
+		{
+			PyObject* data = PyMarshal_WriteObjectToString(code, Py_MARSHAL_VERSION);
+			if(data != NULL)
+			{
+				// The pid keeps instances sharing a host from writing the same 
+				// temporary file.
+#ifdef OMEGA_OS_WIN
+				int pid = _getpid();
+#else
+				int pid = (int)getpid();
+#endif
+				String tmpFile = ostr("%1%.%2%.%3%.tmp", 
+					%cacheFile %SystemManager::instance()->getHostname() %pid);
+				std::ofstream out(tmpFile.c_str(), std::ios::out | std::ios::binary);
+				if(out)
+				{
+					writeCacheInt(out, magic);
+					writeCacheInt(out, mtime);
+					writeCacheInt(out, size);
+					out.write(PyString_AsString(data), PyString_Size(data));
+					out.close();
+					if(rename(tmpFile.c_str(), cacheFile.c_str()) != 0)
+					{
+						// On some platforms rename does not replace existing files.
+						remove(cacheFile.c_str());
+						if(rename(tmpFile.c_str(), cacheFile.c_str()) != 0) remove(tmpFile.c_str());
+					}
+				}
+				else
+				{
+					ofwarn("PythonInterpreter: cannot write script cache file %1%", %tmpFile);
+				}
+				Py_DECREF(data);
+			}
+			else
+			{
+				PyErr_Clear();
+			}
+		}
+	}
+
+	CompiledScript cs;
+	cs.mtime = mtime;
+	cs.size = size;
+	cs.code = code;
+	Py_INCREF(code);
+	myScriptCache[fullPath] = cs;
+	return code;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::clearScriptCache()
+{
+	typedef Dictionary<String, CompiledScript>::Item ScriptCacheItem;
+	foreach(ScriptCacheItem item, myScriptCache)
+	{
+		Py_DECREF((PyObject*)item.getValue().code);
+	}
+	myScriptCache.clear();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::clean()
 {
@@ -467,6 +912,9 @@ void PythonInterpreter::clean()
 	// unregister callbacks
 	unregisterAllCallbacks();
 
+	// Discard compiled commands from the previous application.
+	clearCodeCache();
+
 	// Clear all queued commands.
 	//myInteractiveCommandLock.lock();
 	//myCommandQueue.clear();
@@ -497,23 +945,41 @@ void PythonInterpreter::registerCallback(void* callback, CallbackType type)
 		switch(type)
 		{
 		case CallbackUpdate:
-			myUpdateCallbacks.push_back(callback);
+			myUpdateCallbacks.push_back(ScriptCallback(callback));
 			return;
 		case CallbackEvent:
-			myEventCallbacks.push_back(callback);
+			myEventCallbacks.push_back(ScriptCallback(callback));
 			return;
 		case CallbackDraw:
-			myDrawCallbacks.push_back(callback);
+			myDrawCallbacks.push_back(ScriptCallback(callback));
+			return;
+		case CallbackEventBatch:
+			Py_DECREF(pyCallback);
+			registerEventBatchCallback(callback);
 			return;
 		}
 	}
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::registerEventBatchCallback(void* callback, uint serviceTypeMask)
+{
+	if(callback != NULL)
+	{
+		Py_INCREF((PyObject*)callback);
+		myEventBatchCallbacks.push_back(EventBatchCallback(callback, serviceTypeMask));
+		myEventBatchMask |= serviceTypeMask;
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::unregisterAllCallbacks()
 {
 	myUpdateCallbacks.clear();
 	myEventCallbacks.clear();
+	myEventBatchCallbacks.clear();
+	myEventBatchMask = 0;
+	myEventBatch.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -525,6 +991,8 @@ void PythonInterpreter::update(const UpdateContext& context)
 	{
 		// List of commands to be removed from queue
 		List<QueuedCommand*> cmdsToRemove;
+		// Consecutive single-line python commands, executed as one block.
+		Vector<String> batch;
 		foreach(QueuedCommand* qc, myCommandQueue)
 		{
 			if(qc->needsExecute) 
@@ -533,13 +1001,28 @@ void PythonInterpreter::update(const UpdateContext& context)
 				{
 					ofmsg("running %1%", %qc->command);
 				}
-				// Execute the command
-				eval(qc->command);
+				String cmd = qc->command;
+				StringUtils::trim(cmd);
+				// Batching is disabled while collecting per-command stats.
+				if(myCommandBatchingEnabled && !myCommandStatsEnabled && cmd.length() > 0 && 
+					cmd[0] != ':' && cmd.find('\n') == String::npos)
+				{
+					batch.push_back(cmd);
+				}
+				else
+				{
+					// Execute the command, after the batched commands queued 
+					// before it.
+					evalBatch(batch);
+					batch.clear();
+					eval(qc->command);
+				}
 				qc->needsExecute = false;
 			}
 			// Purge commands from list
 			if(!qc->needsExecute && !qc->needsSend) cmdsToRemove.push_back(qc);
 		}
+		evalBatch(batch);
 		myInteractiveCommandLock.lock();
 		foreach(QueuedCommand* qc, cmdsToRemove)
 		{
@@ -549,14 +1032,20 @@ void PythonInterpreter::update(const UpdateContext& context)
 		myInteractiveCommandLock.unlock();
 	}
 	
+	// Deliver this frame events to event batch callbacks.
+	if(myEventBatch.size() != 0) deliverEventBatch();
+
 	PyObject *arglist;
 	arglist = Py_BuildValue("(lff)", (long int)context.frameNum, context.time, context.dt);
 
-	foreach(void* cb, myUpdateCallbacks)
+	foreach(ScriptCallback& cb, myUpdateCallbacks)
 	{
 		// BLAGH cast
-		PyObject* pyCallback =(PyObject*)cb;
+		PyObject* pyCallback =(PyObject*)cb.callback;
+		Stat* stat = myCallbackStatsEnabled ? getCallbackStat(cb, "update") : NULL;
+		if(stat != NULL) stat->startTiming();
 		PyObject_CallObject(pyCallback, arglist);
+		if(stat != NULL) stat->stopTiming();
 	}
 
 	Py_DECREF(arglist);
@@ -564,13 +1053,67 @@ void PythonInterpreter::update(const UpdateContext& context)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void PythonInterpreter::queueCommand(const String& command, bool local)
+// Returns the event batch mask bit for the event service type. Service types
+// outside the mask range never match any mask.
+static uint getServiceTypeBit(const Event& evt)
+{
+	int serviceType = evt.getServiceType();
+	if(serviceType < 0 || serviceType > 31) return 0;
+	return 1u << serviceType;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::deliverEventBatch()
+{
+	foreach(EventBatchCallback& ebc, myEventBatchCallbacks)
+	{
+		boost::python::list events;
+		int numEvents = 0;
+		foreach(Event* e, myEventBatch)
+		{
+			if(ebc.serviceTypeMask & getServiceTypeBit(*e))
+			{
+				events.append(Ref<Event>(e));
+				numEvents++;
+			}
+		}
+		if(numEvents > 0)
+		{
+			Stat* stat = myCallbackStatsEnabled ? getCallbackStat(ebc, "event batch") : NULL;
+			if(stat != NULL) stat->startTiming();
+			PyObject* result = PyObject_CallFunctionObjArgs(
+				(PyObject*)ebc.callback, events.ptr(), NULL);
+			if(stat != NULL) stat->stopTiming();
+			if(result == NULL) PyErr_Print();
+			else Py_DECREF(result);
+		}
+	}
+	myEventBatch.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::queueCommand(const String& command, bool local, const String& key)
 {
 	//oassert(!myInteractiveCommandNeedsExecute && 
 	//	!myInteractiveCommandNeedsSend);
 	
 	myInteractiveCommandLock.lock();
-	myCommandQueue.push_back(new QueuedCommand(command, true, !local));
+	if(key != "")
+	{
+		// If a command with the same key is still pending, replace it.
+		foreach(QueuedCommand* qc, myCommandQueue)
+		{
+			if(qc->needsExecute && qc->key == key)
+			{
+				qc->command = command;
+				// The replacement decides whether the command is broadcast.
+				qc->needsSend = !local;
+				myInteractiveCommandLock.unlock();
+				return;
+			}
+		}
+	}
+	myCommandQueue.push_back(new QueuedCommand(command, true, !local, key));
 	myInteractiveCommandLock.unlock();
 }
 
@@ -583,14 +1126,18 @@ void PythonInterpreter::commitSharedData(SharedOStream& out)
 
 	// Send commands
 	out << i;
+	int bytes = 0;
 	foreach(QueuedCommand* qc, myCommandQueue) 
 	{
 		if(qc->needsSend)
 		{
 			out << qc->command;
+			bytes += qc->command.length();
 			qc->needsSend = false;
 		}
 	}
+	myCommandCountStat->addSample(i);
+	myCommandBytesStat->addSample(bytes);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -599,13 +1146,17 @@ void PythonInterpreter::updateSharedData(SharedIStream& in)
 	int cmdCount;
 	
 	in >> cmdCount;
+	int bytes = 0;
 	for(int i = 0; i < cmdCount; i++)
 	{
 		String cmd;
 		in >> cmd;
+		bytes += cmd.length();
 		// Add command to the local command queue.
 		queueCommand(cmd, true);
 	}
+	myCommandCountStat->addSample(cmdCount);
+	myCommandBytesStat->addSample(bytes);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -615,11 +1166,22 @@ void PythonInterpreter::handleEvent(const Event& evt)
 	// Script code will be able to retrieve it using getEvent()
 	mysLastEvent = &evt;
 
-	foreach(void* cb, myEventCallbacks)
+	// Store a copy of the event for event batch callbacks. 
+	if(myEventBatchMask & getServiceTypeBit(evt))
+	{
+		Ref<Event> batchEvt = new Event();
+		batchEvt->copyFrom(evt);
+		myEventBatch.push_back(batchEvt);
+	}
+
+	foreach(ScriptCallback& cb, myEventCallbacks)
 	{
 		// BLAGH cast
-		PyObject* pyCallback =(PyObject*)cb;
+		PyObject* pyCallback =(PyObject*)cb.callback;
+		Stat* stat = myCallbackStatsEnabled ? getCallbackStat(cb, "event") : NULL;
+		if(stat != NULL) stat->startTiming();
 		PyObject_CallObject(pyCallback, NULL);
+		if(stat != NULL) stat->stopTiming();
 	}
 
 	// We can't guarantee the event will live outside of this call tree, so 
@@ -648,12 +1210,14 @@ void PythonInterpreter::draw(const DrawContext& context, Camera* cam)
 		boost::python::object odi(boost::python::ptr(di));
 
 		arglist = Py_BuildValue("((ii)(ii)OO)", width, height, tileWidth, tileHeight, ocam.ptr(), odi.ptr());
-		foreach(void* cb, myDrawCallbacks)
+		foreach(ScriptCallback& cb, myDrawCallbacks)
 		{
 			// BLAGH cast
-			PyObject* pyCallback =(PyObject*)cb;
+			PyObject* pyCallback =(PyObject*)cb.callback;
+			Stat* stat = myCallbackStatsEnabled ? getCallbackStat(cb, "draw") : NULL;
+			if(stat != NULL) stat->startTiming();
 			PyObject_CallObject(pyCallback, arglist);
-
+			if(stat != NULL) stat->stopTiming();
 		}
 		Py_DECREF(arglist);
 		unlockInterpreter();
@@ -686,6 +1250,11 @@ bool PythonInterpreter::isEnabled() { return false; }
 PythonInterpreter::PythonInterpreter() 
 { 	
 	myShellEnabled = false;
+	myCodeCacheSize = 0;
+	myCommandStatsEnabled = false;
+	myCallbackStatsEnabled = false;
+	myCallbackStatCount = 0;
+	myCommandBatchingEnabled = false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -720,6 +1289,9 @@ void PythonInterpreter::runFile(const String& filename, uint flags)
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::registerCallback(void* callback, CallbackType type) { }
 
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::registerEventBatchCallback(void* callback, uint serviceTypeMask) { }
+
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::update(const UpdateContext& context) { }
 
@@ -733,7 +1305,7 @@ void PythonInterpreter::commitSharedData(SharedOStream& out) {}
 void PythonInterpreter::updateSharedData(SharedIStream& in) {}
 
 ///////////////////////////////////////////////////////////////////////////////
-void PythonInterpreter::queueCommand(const String& command, bool local) {}
+void PythonInterpreter::queueCommand(const String& command, bool local, const String& key) {}
 
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::unregisterAllCallbacks() {}
@@ -749,4 +1321,16 @@ void PythonInterpreter::clean() {}
 
 ///////////////////////////////////////////////////////////////////////////////
 void PythonInterpreter::cleanRun(const String& filename) {}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::setCodeCacheSize(int value) { myCodeCacheSize = value; }
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::setCommandStatsEnabled(bool value) { myCommandStatsEnabled = value; }
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::clearCodeCache() {}
+
+///////////////////////////////////////////////////////////////////////////////
+void PythonInterpreter::setCallbackStatsEnabled(bool value) { myCallbackStatsEnabled = value; }
 #endif
@@ -42,8 +42,18 @@ RenderTarget::RenderTarget(GpuContext* context, Type type, GLuint id):
     myRbHeight(0),
     myTextureColorTarget(NULL),
     myTextureDepthTarget(NULL),
-    myBound(false)
+    myReadbackColorTarget(NULL),
+    myReadbackDepthTarget(NULL),
+    myBound(false),
+    myAsyncReadback(false),
+    myReadbackIndex(0),
+    myReadbackPboSize(0),
+    myReadbackLatency(0)
 {
+    myReadbackPbo[0] = myReadbackPbo[1] = 0;
+    myReadbackFence[0] = myReadbackFence[1] = NULL;
+    myReadbackTimer.start();
+
     if(myType != RenderOnscreen && myId == 0)
     {
         glGenFramebuffers(1, &myId);
@@ -55,6 +65,15 @@ RenderTarget::RenderTarget(GpuContext* context, Type type, GLuint id):
 RenderTarget::~RenderTarget()
 {
     ofmsg("RenderTarget::~RenderTarget: %1%", %myId);
+    // We may not be running in the thread owning the GL context: queue the
+    // frame and render buffers for deletion.
+    // NOTE: pending readback fences can't be deleted from here and are dropped.
+    unregister();
+    getContext()->queueRelease(GpuContext::ObjectFramebuffer, myId, getGpuMemorySize());
+    getContext()->queueRelease(GpuContext::ObjectRenderbuffer, myRbColorId);
+    getContext()->queueRelease(GpuContext::ObjectRenderbuffer, myRbDepthId);
+    getContext()->queueRelease(GpuContext::ObjectBuffer, myReadbackPbo[0]);
+    getContext()->queueRelease(GpuContext::ObjectBuffer, myReadbackPbo[1]);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -65,6 +84,45 @@ void RenderTarget::dispose()
         glDeleteFramebuffers(1, &myId);
         myId = 0;
     }
+    if(myRbColorId != 0)
+    {
+        glDeleteRenderbuffers(1, &myRbColorId);
+        glDeleteRenderbuffers(1, &myRbDepthId);
+        myRbColorId = 0;
+        myRbDepthId = 0;
+        myRbWidth = 0;
+        myRbHeight = 0;
+    }
+    releaseReadbackBuffers();
+    setGpuMemorySize(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void RenderTarget::updateGpuMemorySize()
+{
+    // RGBA8 color + 32 bit depth renderbuffers, plus the readback pack buffers.
+    setGpuMemorySize(myRbWidth * myRbHeight * 8 + myReadbackPboSize * 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////
+void RenderTarget::releaseReadbackBuffers()
+{
+    for(int i = 0; i < 2; i++)
+    {
+        if(myReadbackFence[i] != NULL)
+        {
+            glDeleteSync((GLsync)myReadbackFence[i]);
+            myReadbackFence[i] = NULL;
+        }
+    }
+    if(myReadbackPbo[0] != 0)
+    {
+        glDeleteBuffers(2, myReadbackPbo);
+        myReadbackPbo[0] = myReadbackPbo[1] = 0;
+    }
+    myReadbackPboSize = 0;
+    myReadbackIndex = 0;
+    updateGpuMemorySize();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -142,7 +200,14 @@ void RenderTarget::readback()
     if(myType != RenderOnscreen && !myBound) needBinding = true;
     if(needBinding) bind();
 
-    if(myReadbackColorTarget != NULL)
+    // If async readback has been turned off, release the pack buffers.
+    if(!myAsyncReadback && myReadbackPbo[0] != 0) releaseReadbackBuffers();
+
+    if(myReadbackColorTarget != NULL && myAsyncReadback)
+    {
+        readbackColorAsync();
+    }
+    else if(myReadbackColorTarget != NULL)
     {
         if(myReadbackColorTarget->getFormat() == PixelData::FormatRgb)
         {
@@ -181,6 +246,88 @@ void RenderTarget::readback()
     if(needBinding) unbind();
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void RenderTarget::readbackColorAsync()
+{
+    GLenum format;
+    int bpp;
+    if(myReadbackColorTarget->getFormat() == PixelData::FormatRgb) 
+    {
+        format = GL_RGB;
+        bpp = 3;
+    }
+    else if(myReadbackColorTarget->getFormat() == PixelData::FormatRgba) 
+    {
+        format = GL_RGBA;
+        bpp = 4;
+    }
+    else return;
+
+    size_t size = myReadbackViewport.width() * myReadbackViewport.height() * bpp;
+
+    // (Re)allocate the pack buffers if the readback size changed. Pending
+    // readbacks are dropped.
+    if(size != myReadbackPboSize)
+    {
+        releaseReadbackBuffers();
+        glGenBuffers(2, myReadbackPbo);
+        for(int i = 0; i < 2; i++)
+        {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, myReadbackPbo[i]);
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if(oglError) return;
+        myReadbackPboSize = size;
+        updateGpuMemorySize();
+    }
+
+    int cur = myReadbackIndex;
+    int prev = 1 - cur;
+
+    // Start reading back this frame into the current pack buffer. This call
+    // returns immediately: the copy completes asynchronously on the GPU.
+    // NOTE: DO NOT CHANGE REDBACK BYTE ORDERING HERE. (see readback)
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, myReadbackPbo[cur]);
+    glReadPixels(
+        myReadbackViewport.x(), myReadbackViewport.y(), 
+        myReadbackViewport.width(), myReadbackViewport.height(), format, GL_UNSIGNED_BYTE, 
+        0);
+    myReadbackFence[cur] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    myReadbackIssueTime[cur] = myReadbackTimer.getElapsedTimeInMilliSec();
+
+    // Deliver the pixels read back during the previous frame.
+    if(myReadbackFence[prev] != NULL)
+    {
+        GLsync fence = (GLsync)myReadbackFence[prev];
+        // The copy was started one frame ago, so this will normally not block.
+        // Wait for at most one second.
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        glDeleteSync(fence);
+        myReadbackFence[prev] = NULL;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, myReadbackPbo[prev]);
+        byte* src = (byte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+        if(src != NULL)
+        {
+            size_t copySize = size;
+            if(copySize > myReadbackColorTarget->getSize()) copySize = myReadbackColorTarget->getSize();
+            byte* dst = myReadbackColorTarget->map();
+            memcpy(dst, src, copySize);
+            myReadbackColorTarget->unmap();
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            myReadbackColorTarget->setDirty();
+
+            myReadbackLatency = (float)(myReadbackTimer.getElapsedTimeInMilliSec() - myReadbackIssueTime[prev]);
+        }
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    myReadbackIndex = prev;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void RenderTarget::bind()
 {
@@ -228,6 +375,7 @@ void RenderTarget::bind()
             glBindRenderbuffer(GL_RENDERBUFFER, myRbDepthId);
             glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32, myRbWidth, myRbHeight);
             glBindRenderbuffer(GL_RENDERBUFFER, 0);
+            updateGpuMemorySize();
         }
 
         glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, myRbColorId);
@@ -44,7 +44,8 @@
 using namespace omega;
 
 ///////////////////////////////////////////////////////////////////////////////
-Renderer::Renderer(Engine* engine)
+Renderer::Renderer(Engine* engine):
+	myGpuMemoryBudget(0)
 {
 	myRenderer = new DrawInterface();
 	myServer = engine;
@@ -54,17 +55,14 @@ Renderer::Renderer(Engine* engine)
 ///////////////////////////////////////////////////////////////////////////////
 Texture* Renderer::createTexture()
 {
-	Texture* tex = new Texture(this->myGpuContext);
-	myResources.push_back(tex);
-	return tex;
+	// NOTE: resources register themselves with their gpu context.
+	return new Texture(this->myGpuContext);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 RenderTarget* Renderer::createRenderTarget(RenderTarget::Type type)
 {
-	RenderTarget* rt = new RenderTarget(this->myGpuContext, type);
-	myResources.push_back(rt);
-	return rt;
+	return new RenderTarget(this->myGpuContext, type);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -122,8 +120,20 @@ void Renderer::initialize()
 		myRenderer->setDefaultFont(fnt);
 	}
 
+	// Read the gpu memory budget (in megabytes)
+	Config* syscfg = getEngine()->getSystemManager()->getSystemConfig();
+	Setting& syscfgroot = syscfg->lookup("config");
+	int budgetMb = Config::getIntValue("gpuMemoryBudget", syscfgroot, 0);
+	myGpuMemoryBudget = (size_t)budgetMb * 1024 * 1024;
+	if(myGpuMemoryBudget != 0)
+	{
+		ofmsg("Renderer(%1%): gpu memory budget %2%MB", %getGpuContext()->getId() %budgetMb);
+	}
+
 	StatsManager* sm = getEngine()->getSystemManager()->getStatsManager();
 	myFrameTimeStat = sm->createStat(ostr("ctx%1% frame", %getGpuContext()->getId()), StatsManager::Time);
+	myGpuMemoryStat = sm->createStat(ostr("ctx%1% gpu memory (MB)", %getGpuContext()->getId()), StatsManager::Memory);
+	myEvictionsStat = sm->createStat(ostr("ctx%1% gpu evictions", %getGpuContext()->getId()), StatsManager::Count1);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -138,6 +148,7 @@ void Renderer::queueCommand(IRendererCommand* cmd)
 void Renderer::startFrame(const FrameInfo& frame)
 {
 	myFrameTimeStat->startTiming();
+	myGpuContext->setFrameNum(frame.frameNum);
 	foreach(Ref<Camera> cam, myServer->getCameras())
 	{
 		cam->startFrame(frame);
@@ -154,17 +165,23 @@ void Renderer::finishFrame(const FrameInfo& frame)
 
 	bool shuttingDown = SystemManager::instance()->isExitRequested();
 
-	// Dispose of unused resources. When shutting down, clean everything.
-	List<GpuResource*> txlist;
-	foreach(GpuResource* tex, myResources)
+	// When shutting down, clean everything.
+	if(shuttingDown) myGpuContext->disposeResources();
+
+	// Delete objects from resources that have been released since the last
+	// frame. Resources queue their objects for deletion when their last 
+	// reference goes away, so we do not need to scan all live resources here.
+	myGpuContext->releaseObjects();
+
+	size_t usage = myGpuContext->getGpuMemoryUsage();
+	if(!shuttingDown && myGpuMemoryBudget != 0 && usage > myGpuMemoryBudget)
 	{
-		if(tex->refCount() == 1 || shuttingDown)
-		{
-			tex->dispose();
-			txlist.push_back(tex);
-		}
+		int evicted = myGpuContext->evictResources(myGpuMemoryBudget);
+		myEvictionsStat->addSample(evicted);
+		usage = myGpuContext->getGpuMemoryUsage();
 	}
-	foreach(GpuResource* gr, txlist) myResources.remove(gr);
+	myGpuMemoryStat->addSample((double)usage / (1024 * 1024));
+
 	myFrameTimeStat->stopTiming();
 }
 
@@ -27,13 +27,21 @@
 
 using namespace omega;
 
-SharedData* SharedDataServices::mysSharedData = NULL;
+SharedObjectRegistry* SharedDataServices::mysSharedData = NULL;
 Dictionary<String, SharedObject*> SharedDataServices::mysRegistrationQueue;
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void SharedOStream::write( const void* data, uint64_t size )
 { 
-	myStream->write(data, size); 
+	if(myStream != NULL)
+	{
+		myStream->write(data, size); 
+	}
+	else
+	{
+		const char* bytes = static_cast<const char*>(data);
+		myBuffer->insert(myBuffer->end(), bytes, bytes + size);
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +59,23 @@ SharedOStream& SharedOStream::operator<< ( const String& str )
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void SharedIStream::read( void* data, uint64_t size )
 { 
-	myStream->read(data, size); 
+	if(myStream != NULL)
+	{
+		myStream->read(data, size); 
+	}
+	else
+	{
+		oassert(size <= getRemainingBufferSize());
+		memcpy(data, myData + myPosition, size);
+		myPosition += size;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+uint64_t SharedIStream::getRemainingBufferSize()
+{
+	if(myStream != NULL) return myStream->getRemainingBufferSize();
+	return mySize - myPosition;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -59,49 +83,52 @@ SharedIStream& SharedIStream::operator>> ( String& str )
 { 
 	uint64_t nElems = 0;
 	read( &nElems, sizeof( nElems ));
-	if(nElems > myStream->getRemainingBufferSize())
+	if(nElems > getRemainingBufferSize())
 	{
 	   oferror("SHaredDataServices: nElems(%1%) > getRemainingBufferSize(%2%)",
-	   %nElems %myStream->getRemainingBufferSize());
+	   %nElems %getRemainingBufferSize());
 	}
-	oassert( nElems <= myStream->getRemainingBufferSize());
+	oassert( nElems <= getRemainingBufferSize());
 	if( nElems == 0 )
 		str.clear();
-	else
+	else if(myStream != NULL)
 	{
 		str.assign( static_cast< const char* >( myStream->getRemainingBuffer( )), 
 					nElems );
 		myStream->advanceBuffer( nElems );
 	}
+	else
+	{
+		str.assign(myData + myPosition, nElems);
+		myPosition += nElems;
+	}
 	return *this; 
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void SharedData::registerObject(SharedObject* module, const String& sharedId)
+void SharedObjectRegistry::registerObject(SharedObject* module, const String& sharedId)
 {
 	//ofmsg("SharedData::registerObject: registering %1%", %sharedId);
 	myObjects[sharedId] = module;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void SharedData::unregisterObject(const String& sharedId)
+void SharedObjectRegistry::unregisterObject(const String& sharedId)
 {
 	//ofmsg("SharedData::unregisterObject: unregistering %1%", %sharedId);
 	myObjects.erase(sharedId);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void SharedData::getInstanceData( co::DataOStream& os )
+void SharedObjectRegistry::serializeObjects(SharedOStream& out)
 {
-	//omsg("#### SharedData::getInstanceData");
-	SharedOStream out(&os);
-
 	// Serialize update context.
 	out << myUpdateContext.frameNum << myUpdateContext.dt << myUpdateContext.time;
 
 	int numObjects = myObjects.size();
 	out << numObjects;
 
+	typedef Dictionary<String, SharedObject*>::Item SharedObjectItem;
 	foreach(SharedObjectItem obj, myObjects)
 	{
 		out << obj.getKey();
@@ -110,11 +137,8 @@ void SharedData::getInstanceData( co::DataOStream& os )
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void SharedData::applyInstanceData( co::DataIStream& is )
+void SharedObjectRegistry::deserializeObjects(SharedIStream& in)
 {
-	//omsg("#### SharedData::applyInstanceData");
-	SharedIStream in(&is);
-
 	// Desrialize update context.
 	in >> myUpdateContext.frameNum >> myUpdateContext.dt >> myUpdateContext.time;
 
@@ -141,7 +165,33 @@ void SharedData::applyInstanceData( co::DataIStream& is )
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void SharedDataServices::setSharedData(SharedData* data)
+void SharedData::getInstanceData( co::DataOStream& os )
+{
+	//omsg("#### SharedData::getInstanceData");
+	SharedOStream out(&os);
+	if(mySerializedData != NULL)
+	{
+		if(!mySerializedData->empty())
+		{
+			out.write(&(*mySerializedData)[0], mySerializedData->size());
+		}
+	}
+	else
+	{
+		serializeObjects(out);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SharedData::applyInstanceData( co::DataIStream& is )
+{
+	//omsg("#### SharedData::applyInstanceData");
+	SharedIStream in(&is);
+	deserializeObjects(in);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void SharedDataServices::setSharedData(SharedObjectRegistry* data)
 {
 	mysSharedData = data;
 	typedef Dictionary<String, SharedObject*>::Item SharedObjectEntry;
@@ -0,0 +1,546 @@
+/******************************************************************************
+ * THE OMEGA LIB PROJECT
+ *-----------------------------------------------------------------------------
+ * Copyright 2010-2014		Electronic Visualization Laboratory, 
+ *							University of Illinois at Chicago
+ * Authors:										
+ *  Alessandro Febretti		febret@gmail.com
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2010-2014, Electronic Visualization Laboratory,  
+ * University of Illinois at Chicago
+ * All rights reserved.
+ * Redistribution and use in source and binary forms, with or without modification, 
+ * are permitted provided that the following conditions are met:
+ * 
+ * Redistributions of source code must retain the above copyright notice, this 
+ * list of conditions and the following disclaimer. Redistributions in binary 
+ * form must reproduce the above copyright notice, this list of conditions and 
+ * the following disclaimer in the documentation and/or other materials provided 
+ * with the distribution. 
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO THE 
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE 
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL 
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE  GOODS OR 
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER 
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, 
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE 
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *-----------------------------------------------------------------------------
+ * What's in this file
+ *	A shared memory ring buffer used to send frame data from one omegalib 
+ *  instance to other instances running on the same machine.
+ ******************************************************************************/
+#include "omega/SharedMemoryRing.h"
+
+#ifdef OMEGA_OS_WIN
+    #include <windows.h>
+    #define RING_BARRIER() MemoryBarrier()
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <sys/time.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <time.h>
+    #define RING_BARRIER() __sync_synchronize()
+#endif
+
+using namespace omega;
+
+// Ring memory layout: a RingHeader, followed by numSlots slots. Each slot is
+// a RingSlot header followed by slotSize bytes of frame data.
+#define RING_MAGIC 0x474e4952
+
+struct RingReader
+{
+    volatile uint64 readSeq;
+    volatile int active;
+    volatile int expected;
+    float applyTime;
+    float latency;
+};
+
+struct RingHeader
+{
+    volatile uint magic;
+    uint numSlots;
+    uint64 slotSize;
+    uint numReaders;
+    volatile int shutdown;
+    volatile uint64 writeSeq;
+    volatile uint64 sessionToken;
+    RingReader readers[SharedMemoryRing::MaxReaders];
+};
+
+struct RingSlot
+{
+    volatile uint64 seq;
+    uint64 size;
+    double timestamp;
+};
+
+#define RING_HEADER ((RingHeader*)myMemory)
+
+///////////////////////////////////////////////////////////////////////////////
+// Waits for a condition to become true, spinning for a short while before
+// going to sleep. Returns false if the condition is still false after timeout
+// seconds.
+#define RING_WAIT(condition, timeout, result) \
+    { \
+        result = true; \
+        double __start = getTime(); \
+        int __spins = 0; \
+        while(!(condition)) \
+        { \
+            if(++__spins > 1000) \
+            { \
+                if(getTime() - __start > timeout) { result = false; break; } \
+                osleep(1); \
+            } \
+        } \
+    }
+
+///////////////////////////////////////////////////////////////////////////////
+double SharedMemoryRing::getTime()
+{
+#ifdef OMEGA_OS_WIN
+    static LARGE_INTEGER sFrequency = { 0 };
+    if(sFrequency.QuadPart == 0) QueryPerformanceFrequency(&sFrequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / sFrequency.QuadPart;
+#elif defined(OMEGA_OS_OSX)
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1000000000.0;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+SharedMemoryRing::SharedMemoryRing():
+    myIsWriter(false),
+    myReaderIndex(0),
+    myMemory(NULL),
+    myMemorySize(0),
+#ifdef OMEGA_OS_WIN
+    myHandle(NULL)
+#else
+    myHandle(-1)
+#endif
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if(myIsWriter) shutdown();
+    else close();
+    unmapSegment();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+SharedMemoryRing* SharedMemoryRing::create(const String& name, 
+    uint numSlots, size_t slotSize, uint numReaders)
+{
+    if(numReaders > MaxReaders)
+    {
+        ofwarn("SharedMemoryRing::create: %1% readers requested, max is %2%", 
+            %numReaders %MaxReaders);
+        return NULL;
+    }
+    if(numSlots == 0) numSlots = 1;
+
+    SharedMemoryRing* ring = new SharedMemoryRing();
+    ring->myName = name;
+    ring->myIsWriter = true;
+
+    size_t size = sizeof(RingHeader) + numSlots * (sizeof(RingSlot) + slotSize);
+    if(!ring->mapSegment(size, true))
+    {
+        delete ring;
+        return NULL;
+    }
+
+    RingHeader* header = (RingHeader*)ring->myMemory;
+    memset(header, 0, sizeof(RingHeader));
+    header->numSlots = numSlots;
+    header->slotSize = slotSize;
+    header->numReaders = numReaders;
+    for(uint i = 0; i < numReaders; i++) header->readers[i].expected = 1;
+    for(uint i = 0; i < numSlots; i++)
+    {
+        ((RingSlot*)ring->getSlot(i + 1))->seq = 0;
+    }
+    // Readers wait for the magic number before accessing the ring.
+    RING_BARRIER();
+    header->magic = RING_MAGIC;
+
+    ofmsg("SharedMemoryRing::create: %1% (%2% slots, %3%KB per slot, %4% readers)",
+        %name %numSlots %(slotSize / 1024) %numReaders);
+    return ring;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+SharedMemoryRing* SharedMemoryRing::open(const String& name, uint readerIndex,
+    double timeout, uint64 sessionToken)
+{
+    if(readerIndex >= MaxReaders)
+    {
+        ofwarn("SharedMemoryRing::open: invalid reader index %1%", %readerIndex);
+        return NULL;
+    }
+
+    SharedMemoryRing* ring = new SharedMemoryRing();
+    ring->myName = name;
+    ring->myReaderIndex = readerIndex;
+
+    // Wait for the writer to create and initialize the segment.
+    double start = getTime();
+    while(!ring->mapSegment(0, false) || 
+        ((RingHeader*)ring->myMemory)->magic != RING_MAGIC)
+    {
+        ring->unmapSegment();
+        if(getTime() - start >= timeout)
+        {
+            // A zero timeout is used to probe for rings that may not exist,
+            // so don't complain in that case.
+            if(timeout > 0) ofwarn("SharedMemoryRing::open: timed out opening %1%", %name);
+            delete ring;
+            return NULL;
+        }
+        osleep(10);
+    }
+    RING_BARRIER();
+
+    RingHeader* header = (RingHeader*)ring->myMemory;
+    if(sessionToken != 0 && header->sessionToken != sessionToken)
+    {
+        ofmsg("SharedMemoryRing::open: %1% belongs to a different session, ignoring it", 
+            %name);
+        // Unmap before deleting, so we do not touch the other session reader
+        // state.
+        ring->unmapSegment();
+        delete ring;
+        return NULL;
+    }
+    if(readerIndex >= header->numReaders || !header->readers[readerIndex].expected)
+    {
+        ofmsg("SharedMemoryRing::open: %1% reader %2% not expected by the writer", 
+            %name %readerIndex);
+        delete ring;
+        return NULL;
+    }
+    RingReader& reader = header->readers[readerIndex];
+    // Start reading from the next frame the writer will publish.
+    reader.readSeq = header->writeSeq;
+    reader.applyTime = 0;
+    reader.latency = 0;
+    RING_BARRIER();
+    reader.active = 1;
+
+    ofmsg("SharedMemoryRing::open: %1% reader %2%", %name %readerIndex);
+    return ring;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool SharedMemoryRing::mapSegment(size_t size, bool create)
+{
+#ifdef OMEGA_OS_WIN
+    if(create)
+    {
+        uint64 size64 = size;
+        myHandle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+            (DWORD)(size64 >> 32), (DWORD)(size64 & 0xffffffff), myName.c_str());
+    }
+    else
+    {
+        myHandle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, myName.c_str());
+    }
+    if(myHandle == NULL) return false;
+
+    myMemory = MapViewOfFile(myHandle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if(myMemory == NULL)
+    {
+        CloseHandle(myHandle);
+        myHandle = NULL;
+        return false;
+    }
+    if(!create)
+    {
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(myMemory, &info, sizeof(info));
+        size = info.RegionSize;
+    }
+#else
+    String shmName = "/" + myName;
+    if(create)
+    {
+        // Remove stale segments left behind by crashed instances.
+        shm_unlink(shmName.c_str());
+        myHandle = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0600);
+        if(myHandle < 0) return false;
+        if(ftruncate(myHandle, size) != 0)
+        {
+            ::close(myHandle);
+            myHandle = -1;
+            return false;
+        }
+    }
+    else
+    {
+        myHandle = shm_open(shmName.c_str(), O_RDWR, 0600);
+        if(myHandle < 0) return false;
+        struct stat st;
+        // The writer may not have sized the segment yet.
+        if(fstat(myHandle, &st) != 0 || (size_t)st.st_size < sizeof(RingHeader))
+        {
+            ::close(myHandle);
+            myHandle = -1;
+            return false;
+        }
+        size = st.st_size;
+    }
+    myMemory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, myHandle, 0);
+    if(myMemory == MAP_FAILED)
+    {
+        myMemory = NULL;
+        ::close(myHandle);
+        myHandle = -1;
+        return false;
+    }
+#endif
+    myMemorySize = size;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::unmapSegment()
+{
+#ifdef OMEGA_OS_WIN
+    if(myMemory != NULL) UnmapViewOfFile(myMemory);
+    if(myHandle != NULL) CloseHandle(myHandle);
+    myHandle = NULL;
+#else
+    if(myMemory != NULL) munmap(myMemory, myMemorySize);
+    if(myHandle >= 0) 
+    {
+        ::close(myHandle);
+        if(myIsWriter) shm_unlink(("/" + myName).c_str());
+    }
+    myHandle = -1;
+#endif
+    myMemory = NULL;
+    myMemorySize = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char* SharedMemoryRing::getSlot(uint64 frame)
+{
+    RingHeader* header = RING_HEADER;
+    size_t slotIndex = (size_t)((frame - 1) % header->numSlots);
+    return (char*)myMemory + sizeof(RingHeader) + 
+        slotIndex * (sizeof(RingSlot) + (size_t)header->slotSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+size_t SharedMemoryRing::getSlotSize()
+{
+    return myMemory != NULL ? (size_t)RING_HEADER->slotSize : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64 SharedMemoryRing::getFramesWritten()
+{
+    return myMemory != NULL ? RING_HEADER->writeSeq : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool SharedMemoryRing::isShutdown()
+{
+    return myMemory == NULL || RING_HEADER->shutdown != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int SharedMemoryRing::getNumActiveReaders()
+{
+    if(myMemory == NULL) return 0;
+    RingHeader* header = RING_HEADER;
+    int n = 0;
+    for(uint i = 0; i < header->numReaders; i++)
+    {
+        if(header->readers[i].active) n++;
+    }
+    return n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::setReaderExpected(uint index, bool expected)
+{
+    oassert(myIsWriter);
+    if(index < RING_HEADER->numReaders) RING_HEADER->readers[index].expected = expected;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int SharedMemoryRing::getNumExpectedReaders()
+{
+    if(myMemory == NULL) return 0;
+    RingHeader* header = RING_HEADER;
+    int n = 0;
+    for(uint i = 0; i < header->numReaders; i++)
+    {
+        if(header->readers[i].expected) n++;
+    }
+    return n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool SharedMemoryRing::waitForReaders(double timeout)
+{
+    oassert(myIsWriter);
+    int numReaders = getNumExpectedReaders();
+    bool ok;
+    RING_WAIT(getNumActiveReaders() == numReaders, timeout, ok);
+    if(!ok)
+    {
+        ofwarn("SharedMemoryRing::waitForReaders: %1% of %2% readers attached",
+            %getNumActiveReaders() %numReaders);
+    }
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool SharedMemoryRing::write(const void* data, size_t size, double timeout)
+{
+    oassert(myIsWriter);
+    RingHeader* header = RING_HEADER;
+    if(size > header->slotSize)
+    {
+        ofwarn("SharedMemoryRing::write: frame size %1% exceeds slot size %2%",
+            %size %header->slotSize);
+        return false;
+    }
+
+    uint64 frame = header->writeSeq + 1;
+
+    // Make sure no active reader still needs the frame stored in the slot we
+    // are about to overwrite.
+    if(frame > header->numSlots)
+    {
+        uint64 minReadSeq = frame - header->numSlots;
+        for(uint i = 0; i < header->numReaders; i++)
+        {
+            RingReader& reader = header->readers[i];
+            bool ok;
+            RING_WAIT(!reader.active || reader.readSeq >= minReadSeq, timeout, ok);
+            if(!ok)
+            {
+                ofwarn("SharedMemoryRing::write: reader %1% not responding, detaching it", %i);
+                reader.active = 0;
+            }
+        }
+    }
+
+    RingSlot* slot = (RingSlot*)getSlot(frame);
+    memcpy((char*)slot + sizeof(RingSlot), data, size);
+    slot->size = size;
+    slot->timestamp = getTime();
+    slot->seq = frame;
+    RING_BARRIER();
+    header->writeSeq = frame;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool SharedMemoryRing::read(Vector<char>& data, double& timestamp, double timeout)
+{
+    oassert(!myIsWriter);
+    RingHeader* header = RING_HEADER;
+    RingReader& reader = header->readers[myReaderIndex];
+    if(!reader.active)
+    {
+        owarn("SharedMemoryRing::read: reader has been detached by the writer");
+        return false;
+    }
+
+    uint64 frame = reader.readSeq + 1;
+    bool ok;
+    RING_WAIT(header->writeSeq >= frame || header->shutdown, timeout, ok);
+    if(!ok || header->writeSeq < frame) return false;
+    RING_BARRIER();
+
+    RingSlot* slot = (RingSlot*)getSlot(frame);
+    data.resize((size_t)slot->size);
+    if(slot->size > 0)
+    {
+        memcpy(&data[0], (char*)slot + sizeof(RingSlot), (size_t)slot->size);
+    }
+    timestamp = slot->timestamp;
+
+    // If the writer detached us while we were copying, the slot may have
+    // been overwritten with a newer frame.
+    RING_BARRIER();
+    if(!reader.active || slot->seq != frame)
+    {
+        owarn("SharedMemoryRing::read: reader has been detached by the writer");
+        return false;
+    }
+    reader.readSeq = frame;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::setReaderStats(float applyTime, float latency)
+{
+    if(myMemory == NULL || myIsWriter) return;
+    RingReader& reader = RING_HEADER->readers[myReaderIndex];
+    reader.applyTime = applyTime;
+    reader.latency = latency;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::getReaderStats(float& maxApplyTime, float& maxLatency)
+{
+    maxApplyTime = 0;
+    maxLatency = 0;
+    if(myMemory == NULL) return;
+    RingHeader* header = RING_HEADER;
+    for(uint i = 0; i < header->numReaders; i++)
+    {
+        RingReader& reader = header->readers[i];
+        if(reader.active)
+        {
+            if(reader.applyTime > maxApplyTime) maxApplyTime = reader.applyTime;
+            if(reader.latency > maxLatency) maxLatency = reader.latency;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::shutdown()
+{
+    if(myMemory == NULL || !myIsWriter) return;
+    RING_BARRIER();
+    RING_HEADER->shutdown = 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::setSessionToken(uint64 token)
+{
+    if(myMemory == NULL || !myIsWriter) return;
+    RING_HEADER->sessionToken = token;
+    RING_BARRIER();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void SharedMemoryRing::close()
+{
+    if(myMemory == NULL || myIsWriter) return;
+    RING_HEADER->readers[myReaderIndex].active = 0;
+}
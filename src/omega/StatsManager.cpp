@@ -36,8 +36,64 @@
 #include "omega/StatsManager.h"
 #include "omega/DrawInterface.h"
 
+#include <algorithm>
+
 using namespace omega;
 
+///////////////////////////////////////////////////////////////////////////////
+float Stat::getPercentile(float fraction)
+{
+	oassert(myValid);
+	int n = myNumSamples < WindowSize ? myNumSamples : WindowSize;
+	Vector<float> samples;
+	samples.assign(myWindow, myWindow + n);
+	int k = (int)(fraction * (n - 1) + 0.5f);
+	std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+	return samples[k];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void Stat::getSummary(StatSummary& summary)
+{
+	oassert(myValid);
+	summary.type = myType;
+	summary.numSamples = myNumSamples;
+	summary.cur = myCur;
+	summary.min = myMin;
+	summary.max = myMax;
+	summary.avg = myAvg;
+	summary.p99 = getPercentile(0.99f);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void ClusterStat::update(const String& node, const StatSummary& summary)
+{
+	myNodes[node] = summary;
+
+	// Recompute the aggregates. Node counts are small, so we just go
+	// through all the nodes every time.
+	Vector<float> avgs;
+	float total = 0;
+	myMaxP99 = 0;
+	typedef KeyValue<String, StatSummary> NodeItem;
+	foreach(NodeItem item, myNodes)
+	{
+		const StatSummary& s = item.getValue();
+		if(avgs.empty() || s.avg > myMaxAvg)
+		{
+			myMaxAvg = s.avg;
+			myOutlierNode = item.getKey();
+		}
+		if(avgs.empty() || s.avg < myMinAvg) myMinAvg = s.avg;
+		if(s.p99 > myMaxP99) myMaxP99 = s.p99;
+		total += s.avg;
+		avgs.push_back(s.avg);
+	}
+	myAvg = total / avgs.size();
+	std::nth_element(avgs.begin(), avgs.begin() + avgs.size() / 2, avgs.end());
+	myMedianAvg = avgs[avgs.size() / 2];
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 Stat* Stat::create(const String& name, StatsManager::StatType type)
 {
@@ -78,6 +134,9 @@ void StatsManager::removeStat(Stat* s)
 {
 	oassert(s != NULL);
 	myStatList.remove(s);
+	// Also remove the stat from the dictionary, so findStat will not return
+	// a dangling pointer.
+	if(myStatDictionary[s->getName()] == s) myStatDictionary.erase(s->getName());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -92,6 +151,48 @@ List<Stat*>::Range StatsManager::getStats()
 	return List<Stat*>::Range(myStatList.begin(), myStatList.end());
 }
 
+///////////////////////////////////////////////////////////////////////////////
+ClusterStat* StatsManager::updateClusterStat(const String& name, const String& node, const StatSummary& summary)
+{
+	ClusterStat* cs = findClusterStat(name);
+	if(cs == NULL)
+	{
+		cs = new ClusterStat(name, summary.type);
+		myClusterStatDictionary[name] = cs;
+		myClusterStatList.push_back(cs);
+	}
+	cs->update(node, summary);
+	return cs;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void StatsManager::updateClusterStats(const String& node)
+{
+	StatSummary summary;
+	foreach(Stat* s, myStatList)
+	{
+		if(s->isValid())
+		{
+			s->getSummary(summary);
+			updateClusterStat(s->getName(), node, summary);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+ClusterStat* StatsManager::findClusterStat(const String& name)
+{
+	Dictionary<String, ClusterStat*>::iterator it = myClusterStatDictionary.find(name);
+	if(it == myClusterStatDictionary.end()) return NULL;
+	return it->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+List< Ref<ClusterStat> >::Range StatsManager::getClusterStats()
+{
+	return List< Ref<ClusterStat> >::Range(myClusterStatList.begin(), myClusterStatList.end());
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void StatsManager::printStats()
 {
@@ -104,5 +205,17 @@ void StatsManager::printStats()
 		ofmsg("%-11s %-8.1f %-8.1f %-8.1f %-8.1f", %s->getName().c_str() %s->getCur() %s->getMin() %s->getMax() %s->getAvg());
 		}
 	}
+	if(!myClusterStatList.empty())
+	{
+		omsg("-------------------------------------------------------------------------------- CLUSTER STATS");
+		omsg("NAME        NODES    MINAVG   MAXAVG   AVG      MAXP99   OUTLIER");
+		foreach(ClusterStat* cs, myClusterStatList)
+		{
+			ofmsg("%-11s %-8d %-8.1f %-8.1f %-8.1f %-8.1f %s%s", 
+				%cs->getName().c_str() %cs->getNumNodes() 
+				%cs->getMinAvg() %cs->getMaxAvg() %cs->getAvg() %cs->getMaxP99() 
+				%cs->getOutlierNode().c_str() %(cs->hasOutlier() ? " (!)" : ""));
+		}
+	}
 	omsg("-------------------------------------------------------------------------------- STATS");
 }
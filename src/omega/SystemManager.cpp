@@ -37,6 +37,7 @@
 
 // Display system
 #include "omega/DisplaySystem.h"
+#include "omega/HeadlessDisplaySystem.h"
 #include "omega/ObserverUpdateServiceExt.h"
 #include "omega/ViewRayService.h"
 #include "omega/WandEmulationService.h"
@@ -341,6 +342,10 @@ void SystemManager::setupDisplaySystem()
             oerror("Glut display system support disabled for this build!");
 #endif
         }
+        else if(displaySystemType == "Headless")
+        {
+            ds = new HeadlessDisplaySystem();
+        }
         else
         {
             oferror("invalid display system type: %s", %displaySystemType);
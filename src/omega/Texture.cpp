@@ -36,9 +36,64 @@ bool Texture::sUsePbo = false;
 Texture::Texture(GpuContext* context): 
 	GpuResource(context),
 	myInitialized(false),
+	myEvictable(false),
+	myEvicted(false),
+	myPboId(0),
 	myTextureUnit(GpuContext::TextureUnitInvalid) 
 {}
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+Texture::~Texture()
+{
+	// We may not be running in the thread owning the GL context: queue the 
+	// texture objects for deletion.
+	unregister();
+	if(myInitialized)
+	{
+		getContext()->queueRelease(GpuContext::ObjectTexture, myId, getGpuMemorySize());
+		getContext()->queueRelease(GpuContext::ObjectBuffer, myPboId);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void Texture::dispose()
+{
+	if(myInitialized)
+	{
+		glDeleteTextures(1, &myId);
+		if(myPboId != 0)
+		{
+			glDeleteBuffers(1, &myPboId);
+			myPboId = 0;
+		}
+		myInitialized = false;
+	}
+	setGpuMemorySize(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void Texture::evict()
+{
+	if(myInitialized)
+	{
+		dispose();
+		myEvicted = true;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void Texture::updateGpuMemorySize()
+{
+	int bpp = 4;
+	if(myGlFormat == GL_RGB) bpp = 3;
+	else if(myGlFormat == GL_LUMINANCE || myGlFormat == GL_ALPHA) bpp = 1;
+
+	size_t size = myWidth * myHeight * bpp;
+	// Pixel buffer objects are always allocated as RGBA
+	if(myPboId != 0) size += myWidth * myHeight * 4;
+	setGpuMemorySize(size);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void Texture::initialize(int width, int height, uint format)
 {
@@ -74,6 +129,8 @@ void Texture::initialize(int width, int height, uint format)
 	}
 
 	myInitialized = true;
+	myEvicted = false;
+	updateGpuMemorySize();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +154,7 @@ void Texture::writePixels(PixelData* data)
 			myHeight = h;
 			myWidth = w;
 			glTexImage2D(GL_TEXTURE_2D, 0, myGlFormat, myWidth, myHeight, 0, myGlFormat, GL_UNSIGNED_BYTE, NULL);
+			updateGpuMemorySize();
 		}
 
 		byte* pixels = data->bind(getContext());
@@ -129,6 +187,7 @@ void Texture::writePixels(PixelData* data)
 void Texture::bind(GpuContext::TextureUnit unit)
 {
 	myTextureUnit = unit;
+	touch();
 	glActiveTexture(myTextureUnit);
 	glBindTexture(GL_TEXTURE_2D, myId);
 }
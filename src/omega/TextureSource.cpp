@@ -37,11 +37,16 @@ Texture* TextureSource::getTexture(const DrawContext& context)
 	if(myTextures[id].isNull())
 	{
 		myTextures[id] = context.renderer->createTexture();
+		// Textures created by a texture source can always be regenerated
+		// from it: let the renderer evict them when needed.
+		myTextures[id]->setEvictable(true);
 		myTextureUpdateFlags |= 1 << id;
 	}
 
-	// See if the texture needs refreshing
-	if(myDirty && (myTextureUpdateFlags & (1 << id)))
+	// Refresh the texture if it has been evicted by the renderer or if it 
+	// is out of date. The refresh brings the texture up to date in both 
+	// cases, so the update flag is cleared.
+	if(myTextures[id]->isEvicted() || (myDirty && (myTextureUpdateFlags & (1 << id))))
 	{
 		refreshTexture(myTextures[id], context);
 		myTextureUpdateFlags &= ~(1 << id);
@@ -50,6 +55,7 @@ Texture* TextureSource::getTexture(const DrawContext& context)
 		if(!myTextureUpdateFlags && !myRequireExplicitClean) myDirty = false;
 	}
 
+	myTextures[id]->touch();
 	return myTextures[id];
 }
 
@@ -66,6 +66,9 @@ void ViewRayService::poll()
 	// Can this be moved to initialize?
 	myCanvasSize = myDisplay->getCanvasSize();
 
+	myPointerEvents.clear();
+	myPointerPositions.clear();
+
 	lockEvents();
 	int numEvts = getManager()->getAvailableEvents();
 	for(int i = 0; i < numEvts; i++)
@@ -86,11 +89,25 @@ void ViewRayService::poll()
 					pos[1] * myCanvasSize[1]);
 			}
 
-			Vector2i pos = Vector2i(
+			myPointerEvents.push_back(evt);
+			myPointerPositions.push_back(Vector2i(
 				evt->getPosition().x(),
-				evt->getPosition().y());
+				evt->getPosition().y()));
+		}
+	}
 
-			Ray r = myDisplay->getViewRay(pos);
+	// Convert all pointer positions to view rays in one pass.
+	int numPointers = myPointerEvents.size();
+	if(numPointers > 0)
+	{
+		myPointerRays.resize(numPointers);
+		DisplayUtils::getViewRays(&myPointerPositions[0], numPointers, 
+			&myPointerRays[0], myDisplay->getDisplayConfig());
+
+		for(int i = 0; i < numPointers; i++)
+		{
+			Event* evt = myPointerEvents[i];
+			const Ray& r = myPointerRays[i];
 			evt->setExtraDataType(Event::ExtraDataVector3Array);
 			evt->setExtraDataVector3(0, r.getOrigin());
 			evt->setExtraDataVector3(1, r.getDirection());
@@ -92,9 +92,16 @@ void ChannelImpl::frameDraw( const co::base::uint128_t& frameID )
 
     if(myDC.tile->enabled)
     {
+        // Draw times measure command submission: the gpu may still be
+        // working when drawFrame returns. Swap times include the wait.
+        bool timeline = myWindow->getDisplaySystem()->getDisplayConfig().latencyInstrumentation;
+        if(timeline) FrameTimeline::instance()->markDrawStart(frameID.low());
+
         // (spin is 128 bits, gets truncated to 64... 
         // do we really need 128 bits anyways!?)
         myDC.drawFrame(frameID.low());
+
+        if(timeline) FrameTimeline::instance()->markDrawEnd(frameID.low());
     }
 	
 	// NOTE: This call NEEDS to stay after drawFrames, or frames will not 
@@ -35,57 +35,22 @@ using namespace omega;
 using namespace co::base;
 using namespace std;
 
-///////////////////////////////////////////////////////////////////////////////////////////////
-void EventUtils::serializeEvent(Event& evt, co::DataOStream& os)
-{
-    os << evt.myTimestamp;
-    os << evt.mySourceId;
-    os << evt.myServiceId;
-    os << evt.myServiceType;
-    os << evt.myType;
-    os << evt.myFlags;
-    os << evt.myPosition[0] << evt.myPosition[1] << evt.myPosition[2];
-    os << evt.myOrientation.x() << evt.myOrientation.y() << evt.myOrientation.z() << evt.myOrientation.w();
-
-    // Serialize extra data
-    os << evt.myExtraDataType;
-    os << evt.myExtraDataItems;
-    if(evt.myExtraDataType != Event::ExtraDataNull)
-    {
-        os << evt.myExtraDataValidMask;
-        os.write(evt.myExtraData, evt.getExtraDataSize());
-    }
-}
-
-///////////////////////////////////////////////////////////////////////////////////////////////
-void EventUtils::deserializeEvent(Event& evt, co::DataIStream& is)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// The shared data object id is a random uuid generated by the master each run,
+// and is sent to all nodes by eq::Config::init: we use it to tell the shared
+// memory ring of this session from stale ones left by crashed runs.
+static uint64 getRingSessionToken(const uint128_t& sharedDataId)
 {
-    is >> evt.myTimestamp;
-    is >> evt.mySourceId;
-    is >> evt.myServiceId;
-    is >> evt.myServiceType;
-    is >> evt.myType;
-    is >> evt.myFlags;
-    is >> evt.myPosition[0] >> evt.myPosition[1] >> evt.myPosition[2];
-    is >> evt.myOrientation.x() >> evt.myOrientation.y() >> evt.myOrientation.z() >> evt.myOrientation.w();
-
-    // Deserialize extra data
-    is >> evt.myExtraDataType;
-    is >> evt.myExtraDataItems;
-    if(evt.myExtraDataType != Event::ExtraDataNull)
-    {
-        is >> evt.myExtraDataValidMask;
-        is.read(evt.myExtraData, evt.getExtraDataSize());
-    }
-    if(evt.myExtraDataType == Event::ExtraDataString)
-    {
-        evt.myExtraData[evt.getExtraDataSize()] = '\0';
-    }
+    uint64 token = sharedDataId.high() ^ sharedDataId.low();
+    // Zero means 'no token' for SharedMemoryRing.
+    return token != 0 ? token : 1;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 ConfigImpl::ConfigImpl( co::base::RefPtr< eq::Server > parent): 
-    eq::Config(parent) 
+    eq::Config(parent),
+    myNumSlaveNodes(0),
+    myLastStatsTime(0)
 {
     omsg("[EQ] ConfigImpl::ConfigImpl");
     SharedDataServices::setSharedData(&mySharedData);
@@ -112,8 +77,17 @@ bool ConfigImpl::init()
 {
     omsg("[EQ] ConfigImpl::init");
 
+    // With frame latency enabled, the master can run up to latency frames 
+    // ahead of the slave nodes. Keep enough shared data versions around for
+    // slave nodes that map the object late.
+    int latency = getLatency();
+    mySharedData.setLatency(latency);
     registerObject(&mySharedData);
-    //mySharedData.setAutoObsolete(getLatency());
+    if(latency > 0)
+    {
+        ofmsg("[EQ] ConfigImpl::init: frame latency %1%", %latency);
+        mySharedData.setAutoObsolete(latency + 1);
+    }
 
     SystemManager* sys = SystemManager::instance();
     
@@ -128,6 +102,27 @@ bool ConfigImpl::init()
     StatsManager* sm = SystemManager::instance()->getStatsManager();
     myFpsStat = sm->createStat("fps", StatsManager::Fps);
 
+    // Per-transport shared data bandwidth (bytes per frame). Network bytes 
+    // count one copy of the frame data per remote node.
+    myRing = eqds->getSharedMemoryRing();
+    if(myRing != NULL)
+    {
+        // Slave nodes receive the shared data id only after this, so the
+        // token is always set before they open the ring.
+        myRing->setSessionToken(getRingSessionToken(mySharedData.getID()));
+
+        const DisplayConfig& dcfg = eqds->getDisplayConfig();
+        for(int n = 0; n < dcfg.numNodes; n++)
+        {
+            const DisplayNodeConfig& nc = dcfg.nodes[n];
+            bool enabled = false;
+            for(int i = 0; i < nc.numTiles; i++) enabled |= nc.tiles[i]->enabled;
+            if(enabled && nc.hostname != "local") myNumSlaveNodes++;
+        }
+        myShmBytesStat = sm->createStat("Shared data bytes (shm)", StatsManager::Count1);
+        myNetBytesStat = sm->createStat("Shared data bytes (net)", StatsManager::Count2);
+    }
+
     myGlobalTimer.start();
 
     return eq::Config::init(mySharedData.getID());
@@ -137,9 +132,26 @@ bool ConfigImpl::init()
 void ConfigImpl::mapSharedData(const uint128_t& initID)
 {
     omsg("[EQ] ConfigImpl::mapSharedData");
+
+    // Nodes running on the master machine read shared data from shared 
+    // memory: they do not map the shared object, so the master does not send
+    // them any data through the network.
+    EqualizerDisplaySystem* eqds = (EqualizerDisplaySystem*)SystemManager::instance()->getDisplaySystem();
+    mySharedDataId = initID;
+    myRing = eqds->openSharedMemoryRing(getRingSessionToken(initID));
+    if(myRing != NULL)
+    {
+        omsg("[EQ] ConfigImpl::mapSharedData: using shared memory transport");
+        return;
+    }
+
     if(!mySharedData.isAttached( ))
     {
-        if(!mapObject( &mySharedData, initID))
+        // Change type must match the one used on the master. Start from the 
+        // oldest version still available, later versions will be applied
+        // in order by updateSharedData.
+        mySharedData.setLatency(getLatency());
+        if(!mapObject( &mySharedData, initID, co::VERSION_OLDEST))
         {
             oferror("ConfigImpl::mapSharedData: maoPobject failed (object id = %1%)", %initID);
         }
@@ -213,6 +225,22 @@ bool ConfigImpl::handleEvent(const eq::ConfigEvent* event)
             MouseService::mouseWheelCallback(buttons, wheel, event->data.pointer.x, event->data.pointer.y);
             return true;
         }
+    case FrameTimingEvent::Type:
+        {
+            const FrameTimingEvent* fte = static_cast<const FrameTimingEvent*>(event);
+            FrameTimeline::instance()->addNodeFrame(
+                fte->node, fte->timing, fte->sendTime, FrameTimeline::getTime());
+            return true;
+        }
+    case StatSummaryEvent::Type:
+        {
+            // Stat summary from a slave node: aggregate it with the same stat
+            // on the other nodes.
+            const StatSummaryEvent* sse = static_cast<const StatSummaryEvent*>(event);
+            StatsManager* sm = SystemManager::instance()->getStatsManager();
+            sm->updateClusterStat(sse->stat, sse->node, sse->summary);
+            return true;
+        }
     }
     return Config::handleEvent(event);
 }
@@ -226,11 +254,17 @@ uint32_t ConfigImpl::startFrame( const uint128_t& version )
     float t = (float)myGlobalTimer.getElapsedTimeInSec();
     if(lt == 0) lt = t;
     
+    // The shared data version committed this frame is used as the frame 
+    // id on all nodes (see below), so nodes render with the same frame number
+    // seen by modules in the update context. Shared data is always dirty, so 
+    // each commit increments its version by one.
+    uint128_t frameVersion = mySharedData.getVersion() + 1;
+
     UpdateContext uc;
     uc.dt = t - lt;
     tt += uc.dt;
     uc.time = tt;
-    uc.frameNum = version.low();
+    uc.frameNum = frameVersion.low();
     lt = t;
 
     mySharedData.setUpdateContext(uc);
@@ -241,6 +275,10 @@ uint32_t ConfigImpl::startFrame( const uint128_t& version )
         myFpsStat->addSample(1.0f / uc.dt);
     }
 
+    EqualizerDisplaySystem* eqds = (EqualizerDisplaySystem*)SystemManager::instance()->getDisplaySystem();
+    const DisplayConfig& dcfg = eqds->getDisplayConfig();
+    double pollTime = FrameTimeline::getTime();
+
     // If enabled, broadcast events to other server nodes.
     if(SystemManager::instance()->isMaster())
     {
@@ -275,19 +313,110 @@ uint32_t ConfigImpl::startFrame( const uint128_t& version )
         im->clearEvents();
     }
 
-    // Send shared data.
-    mySharedData.commit();
+    // Send shared data. The committed version is passed to startFrame and
+    // will be received by slave nodes as the frame id: this way slaves always 
+    // apply the shared data (and update context) of the frame they are about
+    // to render, even when running latency frames behind the master.
+    uint128_t sharedDataVersion;
+    if(myRing != NULL)
+    {
+        // Serialize the frame once: the same data is written to shared 
+        // memory for local nodes and sent through the network (by commit) for
+        // remote nodes.
+        mySharedDataBuffer.clear();
+        SharedOStream out(&mySharedDataBuffer);
+        mySharedData.serializeObjects(out);
+
+        mySharedData.setSerializedData(&mySharedDataBuffer);
+        sharedDataVersion = mySharedData.commit();
+        mySharedData.setSerializedData(NULL);
+
+        size_t size = mySharedDataBuffer.size();
+        int localNodes = myRing->getNumActiveReaders();
+        if(localNodes > 0)
+        {
+            if(!myRing->write(size > 0 ? &mySharedDataBuffer[0] : NULL, size, dcfg.sharedMemoryTimeout))
+            {
+                // Local nodes cannot skip a frame without going out of sync.
+                // Shut the ring down: local nodes will see the shutdown when
+                // reading this frame and map the shared data instead.
+                oferror("ConfigImpl::startFrame: shared data frame (%1% bytes) does not fit "
+                    "the shared memory ring, switching local nodes to the network transport. "
+                    "HINT: increase sharedMemorySlotSize", %size);
+                myRing->shutdown();
+                localNodes = 0;
+            }
+        }
+        myShmBytesStat->addSample(localNodes > 0 ? size : 0);
+        myNetBytesStat->addSample(size * (myNumSlaveNodes - localNodes));
+        if(myRing->isShutdown()) myRing = NULL;
+    }
+    else
+    {
+        sharedDataVersion = mySharedData.commit();
+    }
+    if(sharedDataVersion != frameVersion)
+    {
+        ofwarn("ConfigImpl::startFrame: shared data version %1% does not match frame %2%", 
+            %sharedDataVersion.low() %uc.frameNum);
+    }
 
     myServer->update(uc);
 
+    // Add the master stats to the cluster stats, at the same rate slave
+    // nodes send theirs.
+    float statsInterval = dcfg.statsAggregationInterval;
+    if(statsInterval > 0 && uc.time - myLastStatsTime >= statsInterval)
+    {
+        myLastStatsTime = uc.time;
+        SystemManager::instance()->getStatsManager()->updateClusterStats("master");
+    }
+
+    // Nodes report frame stage times using the shared data version as the
+    // frame id. The commit time is taken right before the frame is started 
+    // on the nodes, so the master to node leg used for clock offset 
+    // estimation does not include the master Engine::update.
+    if(dcfg.latencyInstrumentation)
+    {
+        double commitTime = FrameTimeline::getTime();
+        FrameTimeline::instance()->addMasterFrame(sharedDataVersion.low(), pollTime, commitTime);
+    }
+
     // NOTE: This call NEEDS to stay after Engine::update, or frames will not update / display correctly.
-    return eq::Config::startFrame( version );;
+    return eq::Config::startFrame( sharedDataVersion );
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-void ConfigImpl::updateSharedData( )
+void ConfigImpl::updateSharedData(const uint128_t& version)
 {
-    if(!mySharedData.isMaster())
+    if(myRing != NULL && !myRing->isWriter())
+    {
+        // Local node: frames are written to shared memory once per master
+        // frame, in order, so we just read the next one.
+        // If the frame can't be read (the master shut the ring down, detached
+        // this node or is not responding) this node would go out of sync:
+        // switch to the network transport, starting from this frame.
+        EqualizerDisplaySystem* eqds = (EqualizerDisplaySystem*)SystemManager::instance()->getDisplaySystem();
+        double timestamp;
+        if(!myRing->read(mySharedDataBuffer, timestamp, eqds->getDisplayConfig().sharedMemoryTimeout))
+        {
+            oferror("ConfigImpl::updateSharedData: no shared data for frame %1% in shared memory, "
+                "switching to the network transport", %version.low());
+            myRing->close();
+            myRing = NULL;
+            mySharedData.setLatency(getLatency());
+            if(!mapObject(&mySharedData, mySharedDataId, version))
+            {
+                oferror("ConfigImpl::updateSharedData: mapObject failed (object id = %1%)", %mySharedDataId);
+                SystemManager::instance()->postExitRequest();
+            }
+            return;
+        }
+        size_t size = mySharedDataBuffer.size();
+        SharedIStream in(size > 0 ? &mySharedDataBuffer[0] : NULL, size);
+        mySharedData.deserializeObjects(in);
+    }
+    else if(!mySharedData.isMaster())
     {
         // This call will update the shared data on all slave nodes.
         // All registered modules will receive updated data from the master.
@@ -298,7 +427,9 @@ void ConfigImpl::updateSharedData( )
         //   EventSharingModule.updateSharedData
         //   SharedData.applyInstanceData
         //   SharedData.sync
-        mySharedData.sync(co::VERSION_NEXT);
+        // Versions newer than the requested one stay queued until the
+        // corresponding frame starts on this node.
+        mySharedData.sync(version);
     }
 }
 
@@ -34,7 +34,8 @@ using namespace std;
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 NodeImpl::NodeImpl( eq::Config* parent ):
 	Node(parent),
-	myServer(NULL)
+	myServer(NULL),
+	myLastStatsTime(0)
 {
 	omsg("[EQ] NodeImpl::NodeImpl");
 
@@ -84,15 +85,31 @@ bool NodeImpl::configExit()
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void NodeImpl::frameStart( const eq::uint128_t& frameID, const uint32_t frameNumber )
 {
+	EqualizerDisplaySystem* eqds = (EqualizerDisplaySystem*)SystemManager::instance()->getDisplaySystem();
+	const DisplayConfig& dcfg = eqds->getDisplayConfig();
+
 	// If server is not NULL (only on slave nodes) call update here
 	// on the master node, update is invoked in ConfigImpl.
 	if(myServer != NULL)
 	{
 		ConfigImpl* config = (ConfigImpl*)getConfig();
-		config->updateSharedData();
+		config->updateSharedData(frameID);
 
 		const UpdateContext& uc = config->getUpdateContext();
 		myServer->update(uc);
+
+		float statsInterval = dcfg.statsAggregationInterval;
+		if(statsInterval > 0 && uc.time - myLastStatsTime >= statsInterval)
+		{
+			myLastStatsTime = uc.time;
+			sendStatSummaries();
+		}
+	}
+
+	if(dcfg.latencyInstrumentation)
+	{
+		FrameTimeline::instance()->beginFrame(frameID.low());
+		sendFrameTimings(frameID.low());
 	}
 
 	if(!getClient()->isConnected()) getClient()->exitLocal();
@@ -101,3 +118,55 @@ void NodeImpl::frameStart( const eq::uint128_t& frameID, const uint32_t frameNum
 	Node::frameStart(frameID, frameNumber);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void NodeImpl::sendFrameTimings(uint64 frame)
+{
+	// With frame latency, up to latency frames can still be rendering when
+	// a new frame starts. Older frames are complete.
+	uint64 latency = getConfig()->getLatency();
+	if(frame <= latency) return;
+
+	FrameTimeline* timeline = FrameTimeline::instance();
+	SystemManager* sys = SystemManager::instance();
+	FrameTiming timing;
+	while(timeline->popFrame(frame - latency, timing))
+	{
+		if(sys->isMaster())
+		{
+			timeline->addLocalFrame("master", timing);
+		}
+		else
+		{
+			FrameTimingEvent evt;
+			strncpy(evt.node, sys->getHostnameAndPort().c_str(), FrameTimingEvent::MaxNameLength - 1);
+			evt.node[FrameTimingEvent::MaxNameLength - 1] = '\0';
+			evt.timing = timing;
+			evt.sendTime = FrameTimeline::getTime();
+			getConfig()->sendEvent(evt);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+void NodeImpl::sendStatSummaries()
+{
+	StatsManager* sm = SystemManager::instance()->getStatsManager();
+	const String& node = SystemManager::instance()->getHostnameAndPort();
+
+	// One small event per stat. Names longer than the event buffers get 
+	// truncated.
+	StatSummaryEvent evt;
+	strncpy(evt.node, node.c_str(), StatSummaryEvent::MaxNameLength - 1);
+	evt.node[StatSummaryEvent::MaxNameLength - 1] = '\0';
+	foreach(Stat* s, sm->getStats())
+	{
+		if(s->isValid())
+		{
+			strncpy(evt.stat, s->getName().c_str(), StatSummaryEvent::MaxNameLength - 1);
+			evt.stat[StatSummaryEvent::MaxNameLength - 1] = '\0';
+			s->getSummary(evt.summary);
+			getConfig()->sendEvent(evt);
+		}
+	}
+}
+
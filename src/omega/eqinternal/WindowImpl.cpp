@@ -47,7 +47,7 @@ using namespace std;
 ///////////////////////////////////////////////////////////////////////////////
 WindowImpl::WindowImpl(eq::Pipe* parent): 
     eq::Window(parent), myPipe((PipeImpl*)parent),
-	myVisible(true)
+	myVisible(true), myCurrentFrame(0)
 	//myIndex(Vector2i::Zero())
 {}
 
@@ -108,6 +108,8 @@ bool WindowImpl::processEvent(const eq::Event& event)
 	{
 		myTile->pixelSize[0] = event.resize.w;
 		myTile->pixelSize[1] = event.resize.h;
+		// Tile rectangles changed: rebuild the pointer to tile lookup.
+		getDisplaySystem()->getDisplayConfig().updateTileLookup();
 	}
 
     // Other events: just send to application node.
@@ -118,6 +120,7 @@ bool WindowImpl::processEvent(const eq::Event& event)
 void WindowImpl::frameStart( const uint128_t& frameID, const uint32_t frameNumber )
 {
 	eq::Window::frameStart(frameID, frameNumber);
+	myCurrentFrame = frameID.low();
 
     // Invert interleaver based on window position, WIP
     //int windowY = getPixelViewport().y;
@@ -138,6 +141,16 @@ void WindowImpl::frameStart( const uint128_t& frameID, const uint32_t frameNumbe
 	const GLEWContext* glewc = glewGetContext();
 	glewSetContext(glewc);
 }
+
+///////////////////////////////////////////////////////////////////////////////
+void WindowImpl::swapBuffers()
+{
+	eq::Window::swapBuffers();
+	if(getDisplaySystem()->getDisplayConfig().latencyInstrumentation)
+	{
+		FrameTimeline::instance()->markSwap(myCurrentFrame);
+	}
+}
 
 ///////////////////////////////////////////////////////////////////////////////
 Renderer* WindowImpl::getRenderer() 
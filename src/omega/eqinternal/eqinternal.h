@@ -39,7 +39,9 @@
 #include "omega/osystem.h"
 #include "omega/Application.h"
 #include "omega/RenderTarget.h"
+#include "omega/SharedDataServices.h"
 #include "omega/EqualizerDisplaySystem.h"
+#include "omega/FrameTimeline.h"
 
 #define EQ_IGNORE_GLEW
 
@@ -67,39 +69,36 @@ using namespace omega;
 using namespace co::base;
 using namespace std;
 
-namespace omicron {
-	///////////////////////////////////////////////////////////////////////////
-	//! This class provides utility methods for converting omegalib events into
-	//! the stream format used by Equalizer to share data between nodes.
-    class EventUtils
-    {
-    public:
-        static void serializeEvent(Event& evt, co::DataOStream& os);
-        static void deserializeEvent(Event& evt, co::DataIStream& is);
-    private:
-        EventUtils() {}
-    };
-};
-
 namespace omega {
     class RenderTarget;
 	class Camera;
 
 ///////////////////////////////////////////////////////////////////////////////
-class SharedData: public co::Object
+class SharedData: public co::Object, public SharedObjectRegistry
 {
 public:
-	void registerObject(SharedObject* object, const String& id);
-	void unregisterObject(const String& id);
-    // The shared data is unbuffered: we do not store multiple versions of it.
-    // This reduces the memory footprint of large serialized objects (like
-    // the frames generated by the omegaToolkit::ImageBroadcastModule)
-    // But does not work with configurations that have frame latency enabled.
-    // HINT: to support frame latencym change this to INSTANCE, and modify
-    // setAutoObsolete to be = to latency, or more.
-	virtual ChangeType getChangeType() const { return UNBUFFERED; }
-	void setUpdateContext(const UpdateContext& ctx) { myUpdateContext = ctx; }
-	const UpdateContext& getUpdateContext() { return myUpdateContext; }
+	SharedData(): myChangeType(UNBUFFERED), myLatency(0), mySerializedData(NULL) {}
+
+    // With no frame latency the shared data is unbuffered: we do not store 
+    // multiple versions of it. This reduces the memory footprint of large 
+    // serialized objects (like the frames generated by the 
+    // omegaToolkit::ImageBroadcastModule).
+    // With frame latency enabled the shared data is buffered (INSTANCE): 
+    // slave nodes queue the versions they receive while they are still 
+    // rendering previous frames (or before mapping the object), and apply them
+    // in frame order. Each version carries its own update context.
+    // setLatency needs to be called before registering or mapping the object.
+	void setLatency(int latency) 
+	{ 
+		myLatency = latency; 
+		myChangeType = latency > 0 ? INSTANCE : UNBUFFERED; 
+	}
+	int getLatency() { return myLatency; }
+	virtual ChangeType getChangeType() const { return myChangeType; }
+	// When set, getInstanceData sends this data instead of serializing the
+	// shared objects. Used to serialize each frame only once when the same 
+	// data is also sent through the shared memory transport.
+	void setSerializedData(const Vector<char>* data) { mySerializedData = data; }
 
 
 protected:
@@ -107,9 +106,48 @@ protected:
 	virtual void applyInstanceData( co::DataIStream& is );
 
 private:
-	Dictionary<String, SharedObject*> myObjects;
-	typedef Dictionary<String, SharedObject*>::Item SharedObjectItem;
-	UpdateContext myUpdateContext;
+	ChangeType myChangeType;
+	int myLatency;
+	const Vector<char>* mySerializedData;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//! @internal Config event sent periodically by slave nodes to the master, 
+//! carrying the summary of one of their stats.
+struct StatSummaryEvent: public eq::ConfigEvent
+{
+	enum { Type = eq::Event::USER + 1 };
+	static const int MaxNameLength = 64;
+
+	StatSummaryEvent() 
+	{ 
+		size = sizeof(StatSummaryEvent);
+		data.type = Type;
+	}
+
+	char node[MaxNameLength];
+	char stat[MaxNameLength];
+	StatSummary summary;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//! @internal Config event sent by slave nodes to the master for each frame
+//! they complete, when latency instrumentation is enabled. Timestamps are in
+//! the node clock.
+struct FrameTimingEvent: public eq::ConfigEvent
+{
+	enum { Type = eq::Event::USER + 2 };
+	static const int MaxNameLength = 64;
+
+	FrameTimingEvent() 
+	{ 
+		size = sizeof(FrameTimingEvent);
+		data.type = Type;
+	}
+
+	char node[MaxNameLength];
+	FrameTiming timing;
+	double sendTime;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -126,7 +164,7 @@ public:
     virtual bool init();
     virtual bool exit();
 	void mapSharedData(const uint128_t& initID);
-	void updateSharedData();
+	void updateSharedData(const uint128_t& version);
     virtual bool handleEvent(const eq::ConfigEvent* event);
     virtual uint32_t startFrame( const uint128_t& version );
 	const UpdateContext& getUpdateContext();
@@ -141,6 +179,19 @@ private:
 	//! Global fps counter.
 	Ref<Stat> myFpsStat;
 
+	//! Shared memory transport (see DisplayConfig::sharedMemoryTransport)
+	Ref<SharedMemoryRing> myRing;
+	Vector<char> mySharedDataBuffer;
+	//! Shared data object id, used by local nodes to map the shared data
+	//! when falling back to the network transport.
+	uint128_t mySharedDataId;
+	int myNumSlaveNodes;
+	Ref<Stat> myShmBytesStat;
+	Ref<Stat> myNetBytesStat;
+
+	//! Time of the last cluster stats update (master only)
+	float myLastStatsTime;
+
     omicron::Ref<Engine> myServer;
 };
 
@@ -157,10 +208,15 @@ protected:
     virtual bool configInit( const eq::uint128_t& initID );
     virtual bool configExit();
     virtual void frameStart( const eq::uint128_t& frameID, const uint32_t frameNumber );
+    //! Sends summaries of all the local stats to the master.
+    void sendStatSummaries();
+    //! Reports the frames this node finished rendering to the master.
+    void sendFrameTimings(uint64 frame);
 
 private:
     //bool myInitialized;
     omicron::Ref<Engine> myServer;
+    float myLastStatsTime;
     //FrameData myFrameData;
 };
 
@@ -204,9 +260,11 @@ protected:
     virtual bool configInit(const uint128_t& initID);
     virtual void frameStart( const uint128_t& frameID, const uint32_t frameNumber );
 	bool processEvent(const eq::Event& event);
+	virtual void swapBuffers();
 
 private:
 	PipeImpl* myPipe;
+	uint64 myCurrentFrame;
     omicron::Ref<Renderer> myRenderer;
     DisplayTileConfig* myTile;
 	bool myVisible;
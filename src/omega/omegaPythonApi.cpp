@@ -41,6 +41,7 @@
 #include "omega/ImageUtils.h"
 #include "omega/CameraController.h"
 #include "omega/MissionControl.h"
+#include "omega/FrameTimeline.h"
 
 #ifdef OMEGA_USE_PYTHON
 
@@ -148,6 +149,57 @@ static PyObject* omegaEventCallback(PyObject *dummy, PyObject *args)
     return result;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+static PyObject* omegaEventBatchCallback(PyObject *dummy, PyObject *args)
+{
+    PyObject *result = NULL;
+    PyObject *temp;
+    PyObject *serviceTypes = NULL;
+
+    if (PyArg_ParseTuple(args, "O|O", &temp, &serviceTypes)) 
+    {
+        if (!PyCallable_Check(temp)) 
+        {
+            PyErr_SetString(PyExc_TypeError, "parameter must be callable");
+            return NULL;
+        }
+
+        // Build the service type mask from the optional service type list.
+        uint mask = 0xffffffff;
+        if(serviceTypes != NULL && serviceTypes != Py_None)
+        {
+            if(!PySequence_Check(serviceTypes))
+            {
+                PyErr_SetString(PyExc_TypeError, "service types must be a list");
+                return NULL;
+            }
+            mask = 0;
+            Py_ssize_t n = PySequence_Size(serviceTypes);
+            for(Py_ssize_t i = 0; i < n; i++)
+            {
+                PyObject* item = PySequence_GetItem(serviceTypes, i);
+                long serviceType = PyInt_AsLong(item);
+                Py_DECREF(item);
+                if(serviceType == -1 && PyErr_Occurred()) return NULL;
+                if(serviceType < 0 || serviceType > 31)
+                {
+                    PyErr_SetString(PyExc_ValueError, "service type must be between 0 and 31");
+                    return NULL;
+                }
+                mask |= (1u << serviceType);
+            }
+        }
+
+        PythonInterpreter* interp = SystemManager::instance()->getScriptInterpreter();
+        interp->registerEventBatchCallback(temp, mask);
+
+        /* Boilerplate to return "None" */
+        Py_INCREF(Py_None);
+        result = Py_None;
+    }
+    return result;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 static PyObject* omegaDrawCallback(PyObject *dummy, PyObject *args)
 {
@@ -278,6 +330,12 @@ static PyMethodDef omegaMethods[] =
         "setEventFunction(funcRef)\n"
         "Registers a script function to be called when events are received"},
 
+    {"setEventBatchFunction", omegaEventBatchCallback, METH_VARARGS, 
+        "setEventBatchFunction(funcRef, [serviceTypes])\n"
+        "Registers a script function to be called once per frame with the list of events\n"
+        "received during the frame. serviceTypes is an optional list of ServiceType values\n"
+        "used to select the events passed to the function."},
+
     {"setDrawFunction", omegaDrawCallback, METH_VARARGS, 
         "setDrawFunction(funcRef)\n"
         "Registers a script function to be called when drawing"},
@@ -372,16 +430,16 @@ const Event::Flags getButtonSetting(
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void queueCommand(const String& command)
+void queueCommand(const String& command, const String& key = "")
 {
     PythonInterpreter* interp = SystemManager::instance()->getScriptInterpreter();
     // Mark the command as queued locally, since we expect queueCommand to be executed on all nodes
     // when running in a distributed environment
-    interp->queueCommand(command, true);
+    interp->queueCommand(command, true, key);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void broadcastCommand(const String& command)
+void broadcastCommand(const String& command, const String& key = "")
 {
     // This only runs on the master node and sends the command to all slaves. Use the queeuCommand
     // interpreter function again, but this time don't mark the command as local, so it will be sent
@@ -391,7 +449,7 @@ void broadcastCommand(const String& command)
         PythonInterpreter* interp = SystemManager::instance()->getScriptInterpreter();
         // Mark the command as queued locally, since we expect queueCommand to be executed on all nodes
         // when running in a distributed environment
-        interp->queueCommand(command);
+        interp->queueCommand(command, false, key);
     }
 }
 
@@ -885,6 +943,175 @@ int getImageLoaderThreads()
     return ImageUtils::getImageLoaderThreads();
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void setCallbackStatsEnabled(bool value)
+{
+    PythonInterpreter* interp = SystemManager::instance()->getScriptInterpreter();
+    interp->setCallbackStatsEnabled(value);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool isCallbackStatsEnabled()
+{
+    PythonInterpreter* interp = SystemManager::instance()->getScriptInterpreter();
+    return interp->isCallbackStatsEnabled();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes the recent per-node frame timeline to a csv file. Only meaningful on
+// the master, with latencyInstrumentation enabled in the display config.
+bool dumpFrameTimeline(const String& filename)
+{
+    return FrameTimeline::instance()->dumpTimeline(filename);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Checks that a transform buffer holds at least count tuples of the specified 
+// number of floats. None buffers are accepted (the component is skipped).
+bool checkTransformBuffer(PythonBuffer& buf, const object& obj, int count, int components, const char* name)
+{
+    if(obj.ptr() == Py_None) return true;
+    if(!buf.isValid() || !buf.isFloat())
+    {
+        ofwarn("NodeGroup: %1% must be a contiguous float32 buffer", %name);
+        return false;
+    }
+    size_t needed = count * components * sizeof(float);
+    if(buf.getSize() < needed)
+    {
+        ofwarn("NodeGroup: %1% buffer too small (%2% bytes, %3% needed)", 
+            %name %buf.getSize() %needed);
+        return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void nodeGroupAddNodes(NodeGroup* self, const boost::python::list& nodes)
+{
+    // Check all the items first, so the group is left unchanged on errors.
+    int n = len(nodes);
+    for(int i = 0; i < n; i++)
+    {
+        if(object(nodes[i]).ptr() == Py_None)
+        {
+            PyErr_SetString(PyExc_ValueError, "NodeGroup: node list contains None");
+            throw_error_already_set();
+        }
+    }
+    for(int i = 0; i < n; i++) self->addNode(extract<Node*>(nodes[i]));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void nodeGroupSetTransforms(NodeGroup* self, object positions, object orientations, object scales)
+{
+    int n = self->size();
+    PythonBuffer pb(positions.ptr(), false);
+    PythonBuffer ob(orientations.ptr(), false);
+    PythonBuffer sb(scales.ptr(), false);
+    if(checkTransformBuffer(pb, positions, n, 3, "positions") &&
+        checkTransformBuffer(ob, orientations, n, 4, "orientations") &&
+        checkTransformBuffer(sb, scales, n, 3, "scales"))
+    {
+        self->setTransforms(
+            (const float*)pb.getData(), 
+            (const float*)ob.getData(), 
+            (const float*)sb.getData());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void nodeGroupGetDerivedTransforms(NodeGroup* self, object positions, object orientations, object scales)
+{
+    int n = self->size();
+    PythonBuffer pb(positions.ptr(), true);
+    PythonBuffer ob(orientations.ptr(), true);
+    PythonBuffer sb(scales.ptr(), true);
+    if(checkTransformBuffer(pb, positions, n, 3, "positions") &&
+        checkTransformBuffer(ob, orientations, n, 4, "orientations") &&
+        checkTransformBuffer(sb, scales, n, 3, "scales"))
+    {
+        self->getDerivedTransforms(
+            (float*)pb.getData(), 
+            (float*)ob.getData(), 
+            (float*)sb.getData());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void setNodeTransforms(const boost::python::list& nodes, object positions, object orientations, object scales)
+{
+    Ref<NodeGroup> group = NodeGroup::create();
+    nodeGroupAddNodes(group, nodes);
+    nodeGroupSetTransforms(group, positions, orientations, scales);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void getNodeDerivedTransforms(const boost::python::list& nodes, object positions, object orientations, object scales)
+{
+    Ref<NodeGroup> group = NodeGroup::create();
+    nodeGroupAddNodes(group, nodes);
+    nodeGroupGetDerivedTransforms(group, positions, orientations, scales);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// PixelData buffer protocol support. Pixels are exposed as a flat, row-major
+// array of bytes (getPitch() bytes per row), which keeps slice assignment 
+// working on python 2 memoryviews. While buffer views exist the pixel data
+// cannot be resized, and its textures are refreshed every frame.
+static PyBufferProcs sPixelDataBufferProcs;
+
+///////////////////////////////////////////////////////////////////////////////
+static int pixelDataGetBuffer(PyObject* obj, Py_buffer* view, int flags)
+{
+    extract<PixelData*> xpd(obj);
+    PixelData* pd = xpd.check() ? xpd() : NULL;
+    if(pd == NULL)
+    {
+        PyErr_SetString(PyExc_BufferError, "PixelData: invalid object");
+        view->obj = NULL;
+        return -1;
+    }
+
+    byte* data = pd->retainMapping();
+    if(data == NULL)
+    {
+        PyErr_SetString(PyExc_BufferError, "PixelData: pixel buffer object data cannot be accessed from scripts");
+        view->obj = NULL;
+        return -1;
+    }
+    
+    if(PyBuffer_FillInfo(view, obj, data, pd->getSize(), 0, flags) != 0)
+    {
+        pd->releaseMapping();
+        return -1;
+    }
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+static void pixelDataReleaseBuffer(PyObject* obj, Py_buffer* view)
+{
+    extract<PixelData*> xpd(obj);
+    if(xpd.check()) 
+    {
+        PixelData* pd = xpd();
+        if(pd != NULL) pd->releaseMapping();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Installs the buffer protocol handlers on the python PixelData class.
+static void enablePixelDataBuffer(const object& pixelDataClass)
+{
+    PyTypeObject* type = (PyTypeObject*)pixelDataClass.ptr();
+    memset(&sPixelDataBufferProcs, 0, sizeof(PyBufferProcs));
+    sPixelDataBufferProcs.bf_getbuffer = pixelDataGetBuffer;
+    sPixelDataBufferProcs.bf_releasebuffer = pixelDataReleaseBuffer;
+    type->tp_as_buffer = &sPixelDataBufferProcs;
+    type->tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void printModules()
 {
@@ -1002,6 +1229,8 @@ public:
 };
 
 BOOST_PYTHON_FUNCTION_OVERLOADS(querySceneRayOverloads, querySceneRay, 3, 4);
+BOOST_PYTHON_FUNCTION_OVERLOADS(queueCommandOverloads, queueCommand, 1, 2);
+BOOST_PYTHON_FUNCTION_OVERLOADS(broadcastCommandOverloads, broadcastCommand, 1, 2);
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(NodeYawOverloads, yaw, 1, 2) 
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(NodePitchOverloads, pitch, 1, 2) 
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(NodeRollOverloads, roll, 1, 2) 
@@ -1170,6 +1399,21 @@ BOOST_PYTHON_MODULE(omega)
     // NodeList
     //PYAPI_POINTER_LIST(Node, "NodeList")
 
+    // NodeGroup
+    PYAPI_REF_BASE_CLASS(NodeGroup)
+        PYAPI_STATIC_REF_GETTER(NodeGroup, create)
+        PYAPI_METHOD(NodeGroup, addNode)
+        PYAPI_METHOD(NodeGroup, removeNode)
+        PYAPI_METHOD(NodeGroup, clear)
+        PYAPI_METHOD(NodeGroup, size)
+        PYAPI_REF_GETTER(NodeGroup, getNode)
+        .def("addNodes", nodeGroupAddNodes)
+        .def("setTransforms", nodeGroupSetTransforms, 
+            (arg("self"), arg("positions") = object(), arg("orientations") = object(), arg("scales") = object()))
+        .def("getDerivedTransforms", nodeGroupGetDerivedTransforms, 
+            (arg("self"), arg("positions") = object(), arg("orientations") = object(), arg("scales") = object()))
+        ;
+
     // SceneNode
     PYAPI_REF_CLASS(SceneNode, Node)
         PYAPI_STATIC_REF_GETTER(SceneNode, create)
@@ -1231,12 +1475,15 @@ BOOST_PYTHON_MODULE(omega)
         .def_readwrite("forceMono", &DisplayConfig::forceMono)
         .def_readwrite("stereoMode", &DisplayConfig::stereoMode)
         .def_readwrite("panopticStereoEnabled", &DisplayConfig::panopticStereoEnabled)
+        PYAPI_METHOD(DisplayConfig, updateTileLookup)
         ;
 
     // CameraOutput
     PYAPI_REF_BASE_CLASS(CameraOutput)
         PYAPI_METHOD(CameraOutput, setEnabled)
         PYAPI_METHOD(CameraOutput, isEnabled)
+        PYAPI_METHOD(CameraOutput, setAsyncReadback)
+        PYAPI_METHOD(CameraOutput, isAsyncReadback)
         .def("setReadbackTarget", &CameraOutput::setReadbackTarget, CameraOutputReadbackOverloads())
         ;
 
@@ -1342,10 +1589,14 @@ BOOST_PYTHON_MODULE(omega)
             ;
 
     // PixelData
-    PYAPI_REF_BASE_CLASS(PixelData)
+    object pixelDataClass = PYAPI_REF_BASE_CLASS(PixelData)
         PYAPI_STATIC_REF_GETTER(PixelData, create)
         PYAPI_METHOD(PixelData, getWidth)
         PYAPI_METHOD(PixelData, getHeight)
+        PYAPI_METHOD(PixelData, getFormat)
+        PYAPI_METHOD(PixelData, getPitch)
+        PYAPI_METHOD(PixelData, getBpp)
+        PYAPI_METHOD(PixelData, isMapped)
         PYAPI_METHOD(PixelData, beginPixelAccess)
         PYAPI_METHOD(PixelData, setPixel)
         PYAPI_METHOD(PixelData, getPixelR)
@@ -1354,6 +1605,8 @@ BOOST_PYTHON_MODULE(omega)
         PYAPI_METHOD(PixelData, getPixelA)
         PYAPI_METHOD(PixelData, endPixelAccess)
         ;
+    // Expose pixel memory through the buffer protocol (memoryview, numpy).
+    enablePixelDataBuffer(pixelDataClass);
 
     // SoundEnvironment
     PYAPI_REF_BASE_CLASS(SoundEnvironment)
@@ -1465,6 +1718,8 @@ BOOST_PYTHON_MODULE(omega)
         PYAPI_METHOD(Stat, getMin)
         PYAPI_METHOD(Stat, getMax)
         PYAPI_METHOD(Stat, getAvg)
+        PYAPI_METHOD(Stat, getTotal)
+        PYAPI_METHOD(Stat, getNumSamples)
         ;
 
     // Free Functions
@@ -1493,8 +1748,8 @@ BOOST_PYTHON_MODULE(omega)
     def("setTileCamera", setTileCamera);
     def("toggleStereo", toggleStereo);
     def("isStereoEnabled", isStereoEnabled);
-    def("queueCommand", queueCommand);
-    def("broadcastCommand", broadcastCommand);
+    def("queueCommand", queueCommand, queueCommandOverloads());
+    def("broadcastCommand", broadcastCommand, broadcastCommandOverloads());
     def("ogetdataprefix", ogetdataprefix);
     def("osetdataprefix", osetdataprefix);
     def("isMaster", isMaster);
@@ -1510,6 +1765,13 @@ BOOST_PYTHON_MODULE(omega)
     def("isHostInTileSection", isHostInTileSection);
     def("setTilesEnabled", setTilesEnabled);
     def("printModules", printModules);
+    def("setCallbackStatsEnabled", setCallbackStatsEnabled);
+    def("setNodeTransforms", setNodeTransforms, 
+        (arg("nodes"), arg("positions") = object(), arg("orientations") = object(), arg("scales") = object()));
+    def("getNodeDerivedTransforms", getNodeDerivedTransforms, 
+        (arg("nodes"), arg("positions") = object(), arg("orientations") = object(), arg("scales") = object()));
+    def("isCallbackStatsEnabled", isCallbackStatsEnabled);
+    def("dumpFrameTimeline", dumpFrameTimeline);
 
     def("isEventDispatchEnabled", isEventDispatchEnabled);
     def("setEventDispatchEnabled", setEventDispatchEnabled);
@@ -57,7 +57,8 @@ UiModule::UiModule():
 	myPointerInteractionEnabled(true),
 	myGamepadInteractionEnabled(false),
 	myActiveWidget(NULL),
-	myCullingEnabled(true)
+	myCullingEnabled(true),
+	myHitTestIndexEnabled(true)
 {
 	mysInstance = this;
 	// This module has high priority. It will receive events before modules with lower priority.
@@ -98,8 +99,13 @@ void UiModule::initialize()
 		mysClickButton = Event::parseButtonName(Config::getStringValue("clickButton", sUi, "Button1"));
 		myGamepadInteractionEnabled = Config::getBoolValue("gamepadInteractionEnabled", sUi, myGamepadInteractionEnabled);
 		myPointerInteractionEnabled = Config::getBoolValue("pointerInteractionEnabled", sUi, myPointerInteractionEnabled);
+		myHitTestIndexEnabled = Config::getBoolValue("hitTestIndexEnabled", sUi, myHitTestIndexEnabled);
 	}
 
+	StatsManager* sm = getEngine()->getSystemManager()->getStatsManager();
+	myLayoutTimeStat = sm->createStat("ui layout", StatsManager::Time);
+	myPointerDispatchTimeStat = sm->createStat("ui pointer dispatch", StatsManager::Time);
+
 	omsg("UiModule initialization OK");
 }
 
@@ -149,16 +155,23 @@ void UiModule::update(const UpdateContext& context)
 			%vp.min %vp.width() %vp.height());*/
 	}
 
+	myLayoutTimeStat->startTiming();
+
 	// Make sure all widget sizes are up to date (and perform autosize where necessary).
 	myUi->updateSize();
 
 	// Layout ui.
 	myUi->layout();
+
+	myLayoutTimeStat->stopTiming();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 void UiModule::handleEvent(const Event& evt)
 {
+	bool pointer = (evt.getServiceType() == Event::ServiceTypePointer);
+	if(pointer) myPointerDispatchTimeStat->startTiming();
+
 	// If we have an active widget, it always gets the first chance of processing the event.
 	if(myActiveWidget != NULL)
 	{
@@ -168,6 +181,8 @@ void UiModule::handleEvent(const Event& evt)
 	{
 		myUi->handleEvent(evt);
 	}
+
+	if(pointer) myPointerDispatchTimeStat->stopTiming();
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////
@@ -186,6 +186,8 @@ BOOST_PYTHON_MODULE(omegaToolkit)
 		PYAPI_REF_GETTER(UiModule, destroyExtendedUi)
 		PYAPI_METHOD(UiModule, setCullingEnabled)
 		PYAPI_METHOD(UiModule, isCullingEnabled)
+		PYAPI_METHOD(UiModule, setHitTestIndexEnabled)
+		PYAPI_METHOD(UiModule, isHitTestIndexEnabled)
 		;
 
 	// WidgetFactory
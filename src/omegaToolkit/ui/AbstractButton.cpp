@@ -54,6 +54,7 @@ void AbstractButton::update(const omega::UpdateContext& context)
 	Widget::update(context);
 	if(myPressedStateChanged)
 	{
+		requestRedraw();
 		// Button was pressed, and now it's not (that is, it has been clicked). Generate a click event.
 		if(!myPressed)
 		{
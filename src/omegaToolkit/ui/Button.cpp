@@ -63,6 +63,7 @@ Button::Button(Engine* srv):
 	setMaximumHeight(22);
 	myColor = Color(0.2f, 0.2f, 0.2f);
 	myImageEnabled = false;
+	mySubobjectRedrawVersion = 0;
 	setAutosize(true);
 	//setDebugModeEnabled(true);
 }
@@ -107,6 +108,15 @@ void Button::update(const omega::UpdateContext& context)
 	AbstractButton::update(context);
 	myLabel.update(context);
 	myImage.update(context);
+
+	// The label and image are not children of a container, so their redraw
+	// requests are not propagated automatically.
+	uint subobjectRedrawVersion = myLabel.getRedrawVersion() + myImage.getRedrawVersion();
+	if(subobjectRedrawVersion != mySubobjectRedrawVersion)
+	{
+		mySubobjectRedrawVersion = subobjectRedrawVersion;
+		requestRedraw();
+	}
 }
 
 ///////////////////////////////////////////////////////////////////////////////
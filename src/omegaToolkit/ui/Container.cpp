@@ -40,6 +40,8 @@
 
 #include "omegaGl.h"
 
+#include <algorithm>
+
 using namespace omega;
 using namespace omegaToolkit;
 using namespace omegaToolkit::ui;
@@ -63,7 +65,12 @@ Container::Container(Engine* server):
         myGridRows(1),
         myGridColumns(1),
         myClipping(false),
-        myPixelOutputEnabled(false)
+        myPixelOutputEnabled(false),
+        myHitTestIndexValid(false),
+        myHitTestIndexVersion(0),
+        myBoundsMin(Vector2f::Zero()),
+        myBoundsMax(Vector2f::Zero()),
+        myHitTestGridSize(0)
 {
     // Containers have autosize enabled by default.
     setAutosize(true);
@@ -223,9 +230,10 @@ void Container::updateSize()
 {
     if(needLayoutRefresh())
     {
+        // Only children that have been invalidated need their size updated.
         foreach(Widget* w, myChildren)
         {
-            w->updateSize();
+            if(w->needLayoutRefresh()) w->updateSize();
         }
         Widget::updateSize();
     }
@@ -238,21 +246,24 @@ void Container::autosize()
     int height = 0;
     int maxwidth = 0;
     int maxheight = 0;
+    int maxx = 0;
+    int maxy = 0;
+    // Gather all the child size information we need in a single pass.
     foreach(Widget* w, myChildren)
     {
         if(w->getWidth() > maxwidth) maxwidth = w->getWidth();
         if(w->getHeight() > maxheight) maxheight = w->getHeight();
         width += w->getWidth();
         height += w->getHeight();
+
+        const Vector2f& p = w->getPosition();
+        if(p[0] + w->getWidth() > maxx) maxx = p[0] + w->getWidth();
+        if(p[1] + w->getHeight() > maxy) maxy = p[1] + w->getHeight();
     }
     if(myLayout == LayoutHorizontal)
     {
         width += myPadding * getNumChildren();
         height = maxheight;
-        foreach(Widget* w, myChildren)
-        {
-            //w->setActualSize(maxheight, Vertical);
-        }
     }
     else if(myLayout == LayoutVertical)
     {
@@ -260,19 +271,16 @@ void Container::autosize()
         width = maxwidth;
         foreach(Widget* w, myChildren)
         {
+            int oldWidth = w->getWidth();
             w->setActualSize(maxwidth, Horizontal);
+            // Children whose width changed need to lay out their content again.
+            if(w->getWidth() != oldWidth) w->myNeedLayoutRefresh = true;
         }
     }
     else
     {
-        width = 0;
-        height = 0;
-        foreach(Widget* w, myChildren)
-        {
-            const Vector2f& p = w->getPosition();
-            if(p[0] + w->getWidth() > width) width = p[0] + w->getWidth();
-            if(p[1] + w->getHeight() > height) height = p[1] + w->getHeight();
-        }
+        width = maxx;
+        height = maxy;
     }
 
     width += myMargin * 2;
@@ -315,17 +323,20 @@ void Container::updateChildrenNavigation()
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-int Container::expandStep(int availableSpace, Orientation orientation)
+int Container::expandStep(int availableSpace, Orientation orientation, bool& expanded)
 {
     // Check space constraints for each child
     int childSpace = availableSpace / getNumChildren();
     int spaceLeft = availableSpace;
 
+    expanded = false;
     foreach(Widget* w, myChildren)
     {
-        int size = w->getSize()[orientation] + childSpace;
-        w->setActualSize(size, orientation);
-        spaceLeft -= (orientation == Horizontal ? w->getWidth(): w->getHeight());
+        int oldSize = w->getSize()[orientation];
+        w->setActualSize(oldSize + childSpace, orientation);
+        int newSize = (orientation == Horizontal ? w->getWidth(): w->getHeight());
+        if(newSize != oldSize) expanded = true;
+        spaceLeft -= newSize;
     }
     return spaceLeft;
 }
@@ -421,9 +432,13 @@ void Container::computeLinearLayout(Orientation orientation)
     int availableSpace = getSize()[orientation] - myPadding * 2 - (nc - 1) * myMargin;
 
     resetChildrenSize(orientation);
-    while(availableSpace > 0)
+    bool expanded = true;
+    // If a step did not expand any child, all children reached their maximum
+    // size (or the space left is too small to split): further steps would 
+    // not change anything.
+    while(availableSpace > 0 && expanded)
     {
-        availableSpace = expandStep(availableSpace, orientation) - 1;
+        availableSpace = expandStep(availableSpace, orientation, expanded) - 1;
     }
     updateChildrenLayoutPosition(orientation);
     updateChildrenFreeBounds(oppositeOrientation);
@@ -478,10 +493,16 @@ void Container::computeGridLayout(Orientation orientation)
 ///////////////////////////////////////////////////////////////////////////////
 void Container::layout()
 {
-    if(getNumChildren() != 0)
+    if(needLayoutRefresh())
     {
-        if(needLayoutRefresh())
+        if(getNumChildren() != 0)
         {
+            // Remember the current child sizes, so we can find out which
+            // children get resized by this layout pass.
+            Vector<Vector2f> childSizes;
+            childSizes.reserve(getNumChildren());
+            foreach(Widget* w, myChildren) childSizes.push_back(w->getSize());
+
             if(myLayout == LayoutHorizontal)
             {
                 computeLinearLayout(Horizontal);
@@ -499,14 +520,16 @@ void Container::layout()
                 computeGridLayout(Vertical);
             }
 
-            // Layout children.
+            // Layout children. Only children that have been invalidated or
+            // resized need to run their layout: other subtrees stay as they are.
+            int i = 0;
             foreach(Widget* w, myChildren)
             {
-                w->layout();
+                if(w->getSize() != childSizes[i++]) w->myNeedLayoutRefresh = true;
+                if(w->needLayoutRefresh()) w->layout();
             }
-
-            Widget::layout();
         }
+        Widget::layout();
     }
 }
 
@@ -530,6 +553,7 @@ bool Container::isClippingEnabled()
 void Container::setClippingEnabled(bool value)
 {
     this->myClipping = value;
+    requestRedraw();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -553,6 +577,22 @@ bool Container::rayToPointerEvent(const Event& inEvt, Event& outEvt)
         return false;
     }
 
+    std::pair<bool, Vector2f> res;
+    if(raysToPointers(&r, 1, &res) > 0)
+    {
+        Vector3f pointerPosition(res.second[0], res.second[1], 0);
+        outEvt.reset(inEvt.getType(), Service::Pointer);
+        outEvt.setPosition(pointerPosition);
+        outEvt.setFlags(inEvt.getFlags());
+        return true;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int Container::raysToPointers(const Ray* rays, int count, std::pair<bool, Vector2f>* points)
+{
     // Intersect the pointer ray with the container 3d plane.
     Vector3f pos = my3dSettings.position;
     Vector3f normal = my3dSettings.normal;
@@ -579,38 +619,48 @@ bool Container::rayToPointerEvent(const Event& inEvt, Event& outEvt)
     }
 
     Plane plane(normal, pos);
-    std::pair<bool, float> result = Math::intersects(r, plane);
-    if(result.first)
-    {
-        // An intersection exists: find the point.
-        Vector3f intersection = r.getPoint(result.second);
 
-        // Turn the intersection point from world coordinates to pixel, ui coordinates.
-        intersection = pos - intersection;
-        
-        Vector3f widthVector = -my3dSettings.up.cross(my3dSettings.normal);
-        Vector3f heightVector = -my3dSettings.up;
+    // Vectors used to turn intersection points from world coordinates to 
+    // pixel, ui coordinates.
+    Vector3f widthVector = -my3dSettings.up.cross(my3dSettings.normal);
+    Vector3f heightVector = -my3dSettings.up;
 
-        widthVector.normalize();
-        heightVector.normalize();
+    widthVector.normalize();
+    heightVector.normalize();
 
-        float x = intersection.dot(widthVector);
-        float y = intersection.dot(heightVector);
+    float invScale = 1.0f / my3dSettings.scale;
+    float height = getHeight();
 
-        Vector3f pointerPosition(x / my3dSettings.scale + myPosition[0], getHeight() - (y / my3dSettings.scale) + myPosition[1], 0);
-        outEvt.reset(inEvt.getType(), Service::Pointer);
-        outEvt.setPosition(pointerPosition);
-        outEvt.setFlags(inEvt.getFlags());
+    int hits = 0;
+    for(int i = 0; i < count; i++)
+    {
+        const Ray& r = rays[i];
+        std::pair<bool, float> result = Math::intersects(r, plane);
+        if(result.first)
+        {
+            // An intersection exists: find the point.
+            Vector3f intersection = pos - r.getPoint(result.second);
+
+            float x = intersection.dot(widthVector);
+            float y = intersection.dot(heightVector);
+
+            points[i].first = true;
+            points[i].second = Vector2f(x * invScale + myPosition[0], height - (y * invScale) + myPosition[1]);
+            hits++;
 
-        if(isDebugModeEnabled())
+            if(isDebugModeEnabled())
+            {
+                ofmsg("intersection: %1%    ui pos: %2%", %intersection %points[i].second);
+            }
+        }
+        else
         {
-            ofmsg("intersection: %1%    ui pos: %2%", %intersection %pointerPosition);
+            points[i].first = false;
+            points[i].second = Vector2f::Zero();
         }
-
-        return true;
     }
 
-    return false;
+    return hits;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -647,10 +697,7 @@ void Container::handleEvent(const Event& evt)
             Event newEvt;
             if(rayToPointerEvent(evt, newEvt))
             {
-                foreach(Widget* w, myChildren)
-                {
-                    w->handleEvent(newEvt);
-                }
+                dispatchToChildren(newEvt);
             }
             // Copy back processe flag into original event.
             if(newEvt.isProcessed()) evt.setProcessed();
@@ -659,11 +706,8 @@ void Container::handleEvent(const Event& evt)
         {
             if(isPointerInteractionEnabled())
             {
-                // For pointer interaction, just dispatch the event to all children
-                foreach(Widget* w, myChildren)
-                {
-                    w->handleEvent(evt);
-                }
+                // For pointer interaction, just dispatch the event to the children
+                dispatchToChildren(evt);
             }
         }
         // If this container is draggable, let the widget base class handle
@@ -672,6 +716,151 @@ void Container::handleEvent(const Event& evt)
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void Container::dispatchToChildren(const Event& evt)
+{
+    if(evt.getServiceType() != Event::ServiceTypePointer ||
+        !UiModule::instance()->isHitTestIndexEnabled())
+    {
+        foreach(Widget* w, myChildren)
+        {
+            w->handleEvent(evt);
+        }
+        return;
+    }
+
+    updateHitTestIndex();
+
+    // Find the pointer position in container coordinates, and gather the
+    // children that may be under it.
+    Vector2f point = transformPoint(Vector2f(evt.getPosition().x(), evt.getPosition().y()));
+    Vector<HitTestEntry> candidates;
+
+    int x = (int)((point[0] - myBoundsMin[0]) / myHitTestCellSize[0]);
+    int y = (int)((point[1] - myBoundsMin[1]) / myHitTestCellSize[1]);
+    if(point[0] >= myBoundsMin[0] && point[1] >= myBoundsMin[1] &&
+        x < myHitTestGridSize && y < myHitTestGridSize)
+    {
+        foreach(const HitTestEntry& e, myHitTestCells[y * myHitTestGridSize + x])
+        {
+            if(point[0] >= e.min[0] && point[1] >= e.min[1] &&
+                point[0] < e.max[0] && point[1] < e.max[1])
+            {
+                candidates.push_back(e);
+            }
+        }
+    }
+    foreach(const HitTestEntry& e, myHitTestUnindexed)
+    {
+        candidates.push_back(e);
+    }
+    // 3D mode can be toggled on child containers without invalidating the
+    // index, so check it here.
+    foreach(const HitTestEntry& e, myHitTestContainers)
+    {
+        Container* c = (Container*)e.widget;
+        if(c->get3dSettings().enable3d) candidates.push_back(e);
+    }
+
+    // Dispatch in child order, as if we were going through all children.
+    int lastIndex = -1;
+    if(candidates.size() > 1)
+    {
+        std::sort(candidates.begin(), candidates.end());
+    }
+    foreach(const HitTestEntry& e, candidates)
+    {
+        if(e.index != lastIndex) e.widget->handleEvent(evt);
+        lastIndex = e.index;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void Container::updateHitTestIndex()
+{
+    uint version = getRedrawVersion();
+    if(myHitTestIndexValid && myHitTestIndexVersion == version) return;
+    myHitTestIndexValid = true;
+    myHitTestIndexVersion = version;
+
+    myHitTestCells.clear();
+    myHitTestUnindexed.clear();
+    myHitTestContainers.clear();
+
+    // Compute the bounds of all children (and their descendants), and the
+    // total bounds of this container.
+    Vector<HitTestEntry> entries;
+    entries.reserve(getNumChildren());
+    myBoundsMin = Vector2f::Zero();
+    myBoundsMax = mySize;
+    int index = 0;
+    foreach(Widget* w, myChildren)
+    {
+        HitTestEntry e;
+        e.index = index++;
+        e.widget = w;
+        e.min = Vector2f::Zero();
+        e.max = w->getSize();
+
+        Container* c = dynamic_cast<Container*>(w);
+        if(c != NULL)
+        {
+            myHitTestContainers.push_back(e);
+            // 3D containers are dispatched through myHitTestContainers.
+            if(c->get3dSettings().enable3d) continue;
+            c->updateHitTestIndex();
+            e.min = c->myBoundsMin;
+            e.max = c->myBoundsMax;
+        }
+
+        // We do not index rotated widgets: they always get pointer events.
+        if(w->getRotation() != 0)
+        {
+            myHitTestUnindexed.push_back(e);
+        }
+        else
+        {
+            // Convert the child bounds to container coordinates 
+            // (this is the inverse of Widget::transformPoint)
+            float s = w->getScale();
+            Vector2f offset = w->getPosition() + w->getSize() * (1 - s) * 0.5f;
+            e.min = e.min * s + offset;
+            e.max = e.max * s + offset;
+            myBoundsMin = myBoundsMin.cwiseMin(e.min);
+            myBoundsMax = myBoundsMax.cwiseMax(e.max);
+            entries.push_back(e);
+        }
+    }
+
+    // Build a uniform grid over the indexed children. Each child is added 
+    // to all the cells it overlaps.
+    myHitTestGridSize = (int)ceil(sqrt((float)entries.size()));
+    if(myHitTestGridSize < 1) myHitTestGridSize = 1;
+    if(myHitTestGridSize > MaxHitTestGridSize) myHitTestGridSize = MaxHitTestGridSize;
+    myHitTestCells.resize(myHitTestGridSize * myHitTestGridSize);
+
+    myHitTestCellSize = (myBoundsMax - myBoundsMin) / myHitTestGridSize;
+    if(myHitTestCellSize[0] < 1) myHitTestCellSize[0] = 1;
+    if(myHitTestCellSize[1] < 1) myHitTestCellSize[1] = 1;
+
+    foreach(const HitTestEntry& e, entries)
+    {
+        int x1 = (int)((e.min[0] - myBoundsMin[0]) / myHitTestCellSize[0]);
+        int y1 = (int)((e.min[1] - myBoundsMin[1]) / myHitTestCellSize[1]);
+        int x2 = (int)((e.max[0] - myBoundsMin[0]) / myHitTestCellSize[0]);
+        int y2 = (int)((e.max[1] - myBoundsMin[1]) / myHitTestCellSize[1]);
+        if(x2 >= myHitTestGridSize) x2 = myHitTestGridSize - 1;
+        if(y2 >= myHitTestGridSize) y2 = myHitTestGridSize - 1;
+        for(int y = y1; y <= y2; y++)
+        {
+            for(int x = x1; x <= x2; x++)
+            {
+                myHitTestCells[y * myHitTestGridSize + x].push_back(e);
+            }
+        }
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void Container::activate()
 {
@@ -831,10 +1020,11 @@ void ContainerRenderable::draw3d(const DrawContext& context)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void ContainerRenderable::beginDraw(const DrawContext& context)
+bool ContainerRenderable::beginDraw(const DrawContext& context)
 {
     if(myOwner->get3dSettings().enable3d || myOwner->isPixelOutputEnabled())
     {
+        bool targetChanged = false;
         if(myOwner->get3dSettings().enable3d)
         {
             if(myRenderTarget == NULL || 
@@ -846,6 +1036,7 @@ void ContainerRenderable::beginDraw(const DrawContext& context)
                 myTexture->initialize(myOwner->getWidth(), myOwner->getHeight());
                 myRenderTarget = r->createRenderTarget(RenderTarget::RenderToTexture);
                 myRenderTarget->setTextureTarget(myTexture);
+                targetChanged = true;
             }
         }
         else if(myOwner->isPixelOutputEnabled())
@@ -860,10 +1051,25 @@ void ContainerRenderable::beginDraw(const DrawContext& context)
                 pixels->resize(myOwner->getWidth(), myOwner->getHeight());
                 myRenderTarget = r->createRenderTarget(RenderTarget::RenderOffscreen);
                 myRenderTarget->setReadbackTarget(pixels);
+                targetChanged = true;
             }
-            pixels->setDirty(true);
         }
 
+        // If nothing changed in the container since the frame we last 
+        // rendered it in, keep the current render target content.
+        uint version = myOwner->getRedrawVersion();
+        if(targetChanged || version != myRenderedVersion)
+        {
+            myRenderedVersion = version;
+            myRenderedFrame = context.frameNum;
+        }
+        else if(context.frameNum != myRenderedFrame)
+        {
+            return false;
+        }
+
+        if(myOwner->isPixelOutputEnabled()) myOwner->getPixels()->setDirty(true);
+
         glPushAttrib(GL_VIEWPORT_BIT);
         glViewport(0, 0, myOwner->getWidth(), myOwner->getHeight());
                 
@@ -928,6 +1134,7 @@ void ContainerRenderable::beginDraw(const DrawContext& context)
             glStencilFunc(GL_EQUAL, 0x1, 0x1);
         }
     }
+    return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1002,7 +1209,8 @@ void ContainerRenderable::draw(const DrawContext& context)
                 if(!myrect.intersects(vprect)) return;
             }
 
-            beginDraw(context);
+            // Retained containers skip drawing if their content did not change.
+            if(!beginDraw(context)) return;
 
             // draw myself.
             if(myOwner->isStereo())
@@ -82,14 +82,25 @@ void Image::setData(PixelData* value)
 { 
 	myData = value; 
 	setSize(Vector2f(myData->getWidth(), myData->getHeight()));
+	requestRedraw();
 	refresh(); 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void Image::update(const omega::UpdateContext& context)
+{
+	Widget::update(context);
+	// If the image content changed (i.e. for video streams), make sure 
+	// retained containers re-render it.
+	if(myData != NULL && myData->isDirty()) requestRedraw();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void Image::flipX(bool value)
 {
 	if(value) myFlipFlags |= DrawInterface::FlipX;
 	else myFlipFlags &= ~DrawInterface::FlipX;
+	requestRedraw();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -97,6 +108,7 @@ void Image::flipY(bool value)
 {
 	if(value) myFlipFlags |= DrawInterface::FlipY;
 	else myFlipFlags &= ~DrawInterface::FlipY;
+	requestRedraw();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -58,7 +58,9 @@ Label::Label(Engine* srv):
 	myVerticalAlign(AlignMiddle),
 	myHorizontalAlign(AlignCenter),
 	myAutosizeHorizontalPadding(6),
-	myAutosizeVerticalPadding(6)
+	myAutosizeVerticalPadding(6),
+	myTextSize(Vector2f::Zero()),
+	myTextSizeValid(false)
 {
 	// By default labels are set to not enabled, and won't take part in navigation.
 	setEnabled(false);
@@ -83,10 +85,16 @@ void Label::autosize()
     {
         myFont = Engine::instance()->getDefaultFont().filename + " " +
             boost::lexical_cast<String>(Engine::instance()->getDefaultFont().size);
+        myTextSizeValid = false;
     }
 
-	Vector2f size = Font::getTextSize(myText, myFont); //font->computeSize(myText);
-	size += Vector2f(myAutosizeHorizontalPadding, myAutosizeVerticalPadding);
+	// Measuring text is expensive: only do it when the text or font changed.
+	if(!myTextSizeValid)
+	{
+		myTextSize = Font::getTextSize(myText, myFont); //font->computeSize(myText);
+		myTextSizeValid = true;
+	}
+	Vector2f size = myTextSize + Vector2f(myAutosizeHorizontalPadding, myAutosizeVerticalPadding);
 	//if(size[0] > mySize[0] || size[1] > mySize[1])	
 
 	setSize(size);
@@ -117,6 +117,7 @@ void Slider::handleEvent(const Event& evt)
 				if(newValue != myValue)
 				{
 					myValue = newValue;
+					requestRedraw();
 					if(!myDeferUpdate)
 					{
 						Event e;
@@ -172,6 +173,7 @@ void Slider::update(const omega::UpdateContext& context)
 			myValue += myIncrement;
 			if(myValue < 0) myValue = 0;
 			else if(myValue >= myTicks) myValue = myTicks - 1;
+			requestRedraw();
 			if(!myDeferUpdate)
 			{
 				Event e;
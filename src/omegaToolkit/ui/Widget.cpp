@@ -84,7 +84,9 @@ Widget::Widget(Engine* server):
     myDraggable(false),
     myDragging(false),
     myPinned(false),
-    myShaderEnabled(true)
+    myShaderEnabled(true),
+    myNeedLayoutRefresh(true),
+    myRedrawVersion(0)
 {
     myId = mysNameGenerator.getNext();
     myName = mysNameGenerator.generate();
@@ -403,10 +405,21 @@ void Widget::playMenuScrollSound()
 void Widget::requestLayoutRefresh() 
 { 
     myNeedLayoutRefresh = true; 
+    // A layout refresh always implies a redraw. We don't call requestRedraw
+    // here since the layout request is already propagated to our container.
+    myRedrawVersion++;
     if(myContainer != NULL) 
         myContainer->requestLayoutRefresh(); 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void Widget::requestRedraw() 
+{ 
+    myRedrawVersion++;
+    if(myContainer != NULL) 
+        myContainer->requestRedraw(); 
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool Widget::needLayoutRefresh() 
 { 
@@ -437,6 +450,7 @@ void Widget::setActualSize(int value, Orientation orientation, bool force)
             if(value > myMaximumSize[orientation]) value = myMaximumSize[orientation];
         }
         mySize[orientation] = value; 
+        requestRedraw();
     }
 }
 
@@ -537,6 +551,8 @@ void Widget::updateStyle()
     if(bdstyle != "") myBorders[2].fromString(bdstyle);
     bdstyle = getStyleValue("border-left");
     if(bdstyle != "") myBorders[3].fromString(bdstyle);
+
+    requestRedraw();
 }
 
 ///////////////////////////////////////////////////////////////////////////////